@@ -1,10 +1,20 @@
 #include <stdio.h>
-#include <stdlib.h> // malloc, realloc, free, qsort
-#include <string.h> // strdup, strcmp, memmove
+#include <stdlib.h> // malloc, realloc, free, qsort, strtol, strtod
+#include <limits.h> // INT_MAX
+#include <string.h> // strncmp, strcmp, strlen
+#include <pthread.h> // pthread_create, pthread_join
+#include <time.h>	 // clock_gettime
+
+#include "tokenizer.h"
+#include "arena.h"
+#include "adt_heap.h"
 
 #define SORT_BY_WORD 0 // 단어 순 정렬
 #define SORT_BY_FREQ 1 // 빈도 순 정렬
 
+#define MAX_THREADS 256 // -j의 최대 스레드 수
+#define MAX_GROWTH 16.0 // -g의 최대 배율 (용량 계산이 int를 넘지 않도록)
+
 // 구조체 선언
 // 단어 구조체
 typedef struct
@@ -13,12 +23,26 @@ typedef struct
 	int freq;	// 빈도
 } tWord;
 
+// 해시 인덱스 슬롯 구조체
+typedef struct
+{
+	unsigned hash; // 단어의 해시값 (재해싱 시 다시 계산하지 않도록 캐시)
+	int index;	   // data 배열의 인덱스 (-1이면 빈 슬롯)
+} tSlot;
+
 // 사전(dictionary) 구조체
 typedef struct
 {
 	int len;	  // 배열에 저장된 단어의 수
 	int capacity; // 배열의 용량 (배열에 저장 가능한 단어의 수)
 	tWord *data;  // 단어 구조체 배열에 대한 포인터
+	int nslots;	  // 해시 인덱스의 슬롯 수 (2의 거듭제곱, 0이면 인덱스 없음)
+	tSlot *slots; // 해시 인덱스 (open addressing, linear probing)
+	ARENA *words; // 단어 문자열 저장 공간 (destroy_dic에서 한꺼번에 해제)
+
+	double growth;	   // 용량 증가 배율 (1.0 이하이면 1000씩 증가)
+	int nrealloc;	   // data 배열의 realloc 횟수
+	size_t copy_bytes; // realloc으로 옮겨졌을 수 있는 바이트 수 (이전 배열 크기의 합)
 } tWordDic;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -27,12 +51,43 @@ typedef struct
 // 단어를 사전에 저장
 // 새로 등장한 단어는 사전에 추가
 // 이미 사전에 존재하는(저장된) 단어는 해당 단어의 빈도를 갱신(update)
-// capacity는 1000으로부터 시작하여 1000씩 증가 (1000, 2000, 3000, ...)
-void word_count(FILE *fp, tWordDic *dic);
+// capacity는 1000으로부터 시작하여 growth 배율로 증가 (growth가 1.0 이하이면 1000씩 증가)
+// 단어는 해시 인덱스로 찾고 data 배열의 끝에 추가되므로, 출력 전에 sort_dic으로 한 번 정렬해야 함
+// return : 성공 1, 메모리 부족 0
+int word_count(TOKENIZER *tok, tWordDic *dic);
+
+// 입력을 nthreads개의 범위로 나누어 스레드별 사전에 센 후, dic에 합침
+// nthreads가 1 이하이면 word_count와 같음
+// return : 성공 1, 메모리 부족 0
+int word_count_parallel(TOKENIZER *tok, tWordDic *dic, int nthreads);
+
+// src 사전의 단어와 빈도를 dst 사전에 더함 (src는 변경하지 않음)
+// return : 성공 1, 메모리 부족 0
+int merge_dic(tWordDic *dst, tWordDic *src);
+
+// 사전을 초기화 (빈 사전을 생성, 메모리 할당)
+// return : 구조체 pointer, 메모리 부족이면 NULL
+tWordDic *create_dic(void);
+
+// 사전을 compare 기준으로 정렬
+// 정렬 후 해시 인덱스는 무효화되며, 다음 word_count 호출 시 다시 만들어짐
+void sort_dic(tWordDic *dic, int (*compare)(const void *, const void *));
+
+// 단어 n개를 realloc 없이 저장할 수 있도록 배열과 해시 인덱스를 미리 확보
+// return : 성공 1, 메모리 부족 0
+int reserve_dic(tWordDic *dic, int n);
+
+// 입력 파일 크기(바이트)로부터 서로 다른 단어 수를 추정 (reserve_dic의 인자로 사용)
+int size_hint_dic(long long file_size);
 
 // 사전을 화면에 출력 ("단어\t빈도" 형식)
 void print_dic(tWordDic *dic);
 
+// 빈도 상위 k개의 단어를 빈도 내림차순으로 출력 (print_dic과 같은 형식)
+// 사전 전체를 정렬하지 않고 크기 k의 힙으로 고르므로 O(n log k), 추가 메모리 O(k)
+// return : 성공 1, 메모리 부족 0
+int print_top_dic(tWordDic *dic, int k);
+
 // 사전에 할당된 메모리를 해제
 void destroy_dic(tWordDic *dic);
 
@@ -43,57 +98,340 @@ int compare_by_word(const void *n1, const void *n2);
 // 정렬 기준 : 빈도 내림차순(1순위), 단어(2순위)
 int compare_by_freq(const void *n1, const void *n2);
 
-////////////////////////////////////////////////////////////////////////////////
-// 이진탐색 함수
-// found : key가 발견되는 경우 1, key가 발견되지 않는 경우 0
-// return value: key가 발견되는 경우, 배열의 인덱스
-//				key가 발견되지 않는 경우, key가 삽입되어야 할 배열의 인덱스
-int binary_search(const void *key, const void *base, size_t nmemb, size_t size,
-				  int (*compare)(const void *, const void *), int *found);
-
 ////////////////////////////////////////////////////////////////////////////////
 // 함수 정의 (definition)
 /////////////-------위 함수들 구현 여기에 ------------------///////////////////
 
+// 해시 인덱스의 최대 적재율 (len / nslots)
+#define MAX_LOAD_NUM 1
+#define MAX_LOAD_DEN 2
+
+// 해시 함수 (FNV-1a), 길이 len의 단어
+static unsigned hash_word(const char *word, size_t len)
+{
+	unsigned h = 2166136261u;
+	for (size_t i = 0; i < len; i++)
+	{
+		h ^= (unsigned char)word[i];
+		h *= 16777619u;
+	}
+	return h;
+}
+
+// 해시 인덱스를 nslots 크기로 다시 만듦 (nslots는 2의 거듭제곱)
+// old가 NULL이면 data 배열의 단어들로부터 해시값을 계산
+// return : 성공 1, 메모리 부족 0
+static int rehash_dic(tWordDic *dic, int nslots, const tSlot *old, int nold)
+{
+	tSlot *slots = (tSlot *)malloc(nslots * sizeof(tSlot));
+	if (!slots)
+		return 0;
+	for (int i = 0; i < nslots; i++)
+		slots[i].index = -1;
+
+	unsigned mask = (unsigned)nslots - 1;
+	int n = old ? nold : dic->len;
+	for (int i = 0; i < n; i++)
+	{
+		tSlot s;
+		if (old)
+		{
+			if (old[i].index < 0)
+				continue;
+			s = old[i];
+		}
+		else
+		{
+			s.hash = hash_word(dic->data[i].word, strlen(dic->data[i].word));
+			s.index = i;
+		}
+		unsigned pos = s.hash & mask;
+		while (slots[pos].index >= 0)
+			pos = (pos + 1) & mask;
+		slots[pos] = s;
+	}
+	dic->slots = slots;
+	dic->nslots = nslots;
+	return 1;
+}
+
+// data 배열의 용량을 최소 mincap이 되도록 늘림
+// growth 배율로 늘리되, 모자라면 mincap까지 늘림
+// return : 성공 1, 메모리 부족 0
+static int grow_dic(tWordDic *dic, int mincap)
+{
+	int capacity;
+	tWord *data;
+
+	if (mincap <= dic->capacity)
+		return 1;
+
+	if (dic->growth > 1.0)
+		capacity = (int)(dic->capacity * dic->growth);
+	else
+		capacity = dic->capacity + 1000;
+	if (capacity < mincap)
+		capacity = mincap;
+
+	data = (tWord *)realloc(dic->data, capacity * sizeof(tWord));
+	if (!data)
+		return 0;
+
+	dic->nrealloc++;
+	dic->copy_bytes += dic->capacity * sizeof(tWord);
+	dic->data = data;
+	dic->capacity = capacity;
+	return 1;
+}
+
+// 해시 인덱스가 없으면 (정렬 등으로 무효화된 경우) 다시 만듦
+// return : 성공 1, 메모리 부족 0
+static int ensure_index(tWordDic *dic)
+{
+	int nslots = 1024;
+
+	if (dic->nslots)
+		return 1;
+	while (dic->len * MAX_LOAD_DEN >= nslots * MAX_LOAD_NUM)
+		nslots *= 2;
+	return rehash_dic(dic, nslots, NULL, 0);
+}
+
+// 길이 len의 단어(해시값 hash)를 사전에서 찾고, 없으면 빈도 0으로 배열의 끝에 추가
+// return : 단어 구조체 pointer, 메모리 부족이면 NULL
+static tWord *find_or_add(tWordDic *dic, const char *word, size_t len, unsigned hash)
+{
+	unsigned mask = (unsigned)dic->nslots - 1;
+	unsigned pos = hash & mask;
+	tSlot *slot;
+
+	// linear probing, 캐시된 해시값이 같을 때만 문자열 비교
+	while ((slot = &dic->slots[pos])->index >= 0)
+	{
+		if (slot->hash == hash)
+		{
+			const char *w = dic->data[slot->index].word;
+			if (strncmp(w, word, len) == 0 && w[len] == '\0')
+				return &dic->data[slot->index];
+		}
+		pos = (pos + 1) & mask;
+	}
+
+	// 새 단어이면 배열의 끝에 추가
+	if (dic->len == dic->capacity && !grow_dic(dic, dic->len + 1))
+		return NULL;
+	tWord *entry = &dic->data[dic->len];
+	if ((entry->word = arena_StrDup(dic->words, word, len)) == NULL)
+		return NULL;
+	entry->freq = 0;
+	slot->hash = hash;
+	slot->index = dic->len;
+	dic->len++;
+
+	// 적재율을 넘으면 슬롯 수를 2배로 늘림
+	if (dic->len * MAX_LOAD_DEN >= dic->nslots * MAX_LOAD_NUM)
+	{
+		tSlot *old = dic->slots;
+		if (rehash_dic(dic, dic->nslots * 2, old, dic->nslots))
+			free(old);
+	}
+	return entry;
+}
+
 // 단어를 사전에 저장하는 함수 구현
-void word_count(FILE *fp, tWordDic *dic)
+int word_count(TOKENIZER *tok, tWordDic *dic)
 {
-	char buffer[256];
-	while (fscanf(fp, "%255s", buffer) == 1)
+	const char *word;
+	size_t len;
+
+	if (!ensure_index(dic))
+		return 0;
+
+	// 단어는 입력 버퍼를 직접 가리키며 (NUL로 끝나지 않음), 새 단어일 때만 복사
+	while (tok_Next(tok, &word, &len))
 	{
-		// 이진탐색을 위해 임시 tWord 생성 (word 필드만 사용)
-		tWord temp;
-		temp.word = buffer;
-		temp.freq = 0;
+		tWord *entry = find_or_add(dic, word, len, hash_word(word, len));
+		if (!entry)
+			return 0;
+		entry->freq++;
+	}
+	return 1;
+}
 
-		int found;
-		// 사전은 단어순으로 정렬되어 있으므로 이진탐색 사용
-		int index = binary_search(&temp, dic->data, dic->len, sizeof(tWord), compare_by_word, &found);
+// src의 단어를 dst에 더함
+int merge_dic(tWordDic *dst, tWordDic *src)
+{
+	if (!ensure_index(dst))
+		return 0;
 
-		if (found)
+	// src에 인덱스가 있으면 캐시된 해시값을 그대로 사용
+	for (int i = 0; i < src->nslots; i++)
+	{
+		tSlot *s = &src->slots[i];
+		if (s->index < 0)
+			continue;
+		tWord *w = &src->data[s->index];
+		tWord *entry = find_or_add(dst, w->word, strlen(w->word), s->hash);
+		if (!entry)
+			return 0;
+		entry->freq += w->freq;
+	}
+	if (src->nslots == 0)
+	{
+		for (int i = 0; i < src->len; i++)
 		{
-			// 이미 존재하는 단어이면 빈도 증가
-			dic->data[index].freq++;
+			tWord *w = &src->data[i];
+			size_t len = strlen(w->word);
+			tWord *entry = find_or_add(dst, w->word, len, hash_word(w->word, len));
+			if (!entry)
+				return 0;
+			entry->freq += w->freq;
 		}
-		else
+	}
+	return 1;
+}
+
+// 스레드 하나가 맡는 입력 범위와 사전
+typedef struct
+{
+	TOKENIZER *tok;
+	tWordDic *dic;
+	int running; // 1이면 스레드가 실행 중 (join 필요)
+	int ok;		 // word_count의 결과 (0이면 메모리 부족)
+} tShard;
+
+// 스레드 함수: 자기 범위의 단어를 자기 사전에 셈
+static void *count_shard(void *arg)
+{
+	tShard *shard = (tShard *)arg;
+	shard->ok = word_count(shard->tok, shard->dic);
+	return NULL;
+}
+
+// 입력을 나누어 병렬로 센 후 합침
+int word_count_parallel(TOKENIZER *tok, tWordDic *dic, int nthreads)
+{
+	TOKENIZER *parts;
+	tShard *shards;
+	pthread_t *threads;
+	int nshards;
+	int ok = 1;
+
+	if (nthreads <= 1)
+		return word_count(tok, dic);
+
+	parts = tok_Split(tok, nthreads);
+	shards = (tShard *)calloc(nthreads, sizeof(tShard));
+	threads = (pthread_t *)malloc(nthreads * sizeof(pthread_t));
+	if (!parts || !shards || !threads)
+	{
+		tok_FreeSplit(parts, nthreads);
+		free(shards);
+		free(threads);
+		return 0;
+	}
+
+	// 사전을 만들 수 없으면 거기서 멈추고, 이미 시작한 스레드만 기다린 후 실패로 끝냄
+	for (nshards = 0; nshards < nthreads; nshards++)
+	{
+		tShard *shard = &shards[nshards];
+		shard->tok = &parts[nshards];
+		shard->dic = create_dic();
+		if (!shard->dic)
 		{
-			// 새 단어이면 해당 위치에 삽입
-			if (dic->len == dic->capacity)
-			{
-				dic->capacity += 1000;
-				dic->data = (tWord *)realloc(dic->data, dic->capacity * sizeof(tWord));
-			}
-			// 삽입 위치 이후 요소들을 한 칸씩 이동
-			if (index < dic->len)
-			{
-				memmove(&dic->data[index + 1], &dic->data[index], (dic->len - index) * sizeof(tWord));
-			}
-			// 새 단어의 메모리 할당 및 초기화
-			dic->data[index].word = strdup(buffer);
-			dic->data[index].freq = 1;
-			dic->len++;
+			ok = 0;
+			break;
+		}
+		shard->dic->growth = dic->growth;
+		if (dic->growth > 1.0)
+			reserve_dic(shard->dic, size_hint_dic(shard->tok->size));
+		shard->running = 1;
+		if (pthread_create(&threads[nshards], NULL, count_shard, shard) != 0)
+		{
+			// 스레드를 만들 수 없으면 직접 셈
+			shard->running = 0;
+			count_shard(shard);
 		}
 	}
+
+	// 스레드 순서대로 합침 (결과는 정렬 후 출력하므로 순서와 무관)
+	for (int i = 0; i < nshards; i++)
+	{
+		if (shards[i].running)
+			pthread_join(threads[i], NULL);
+		if (ok && !(shards[i].ok && merge_dic(dic, shards[i].dic)))
+			ok = 0;
+		dic->nrealloc += shards[i].dic->nrealloc;
+		dic->copy_bytes += shards[i].dic->copy_bytes;
+		destroy_dic(shards[i].dic);
+	}
+
+	tok_FreeSplit(parts, nthreads);
+	free(shards);
+	free(threads);
+	return ok;
+}
+
+// 단어 n개를 위한 공간을 미리 확보
+int reserve_dic(tWordDic *dic, int n)
+{
+	if (n > dic->capacity)
+	{
+		tWord *data = (tWord *)realloc(dic->data, n * sizeof(tWord));
+		if (!data)
+			return 0;
+		dic->nrealloc++;
+		dic->copy_bytes += dic->capacity * sizeof(tWord);
+		dic->data = data;
+		dic->capacity = n;
+	}
+
+	// n개를 넣어도 적재율을 넘지 않도록 해시 인덱스 크기 조정
+	int nslots = dic->nslots ? dic->nslots : 1024;
+	while (n * MAX_LOAD_DEN >= nslots * MAX_LOAD_NUM)
+		nslots *= 2;
+	if (nslots != dic->nslots)
+	{
+		tSlot *old = dic->slots;
+		if (!rehash_dic(dic, nslots, old, dic->nslots))
+			return 0;
+		free(old);
+	}
+	return 1;
+}
+
+// 서로 다른 단어 수 추정 (Heaps' law: V = K * N^0.5)
+// 단어 하나를 평균 6바이트(공백 포함)로 보고 N을 계산
+int size_hint_dic(long long file_size)
+{
+	long long tokens = file_size / 6;
+	long long root = 1;
+
+	// 정수 제곱근 (Newton 방법)
+	if (tokens > 1)
+	{
+		root = tokens;
+		while (root * root > tokens)
+			root = (root + tokens / root) / 2;
+	}
+
+	long long vocab = 30 * root;
+	if (vocab > tokens)
+		vocab = tokens;
+	if (vocab > 100000000)
+		vocab = 100000000;
+	return (int)vocab;
+}
+
+// 사전을 compare 기준으로 정렬
+void sort_dic(tWordDic *dic, int (*compare)(const void *, const void *))
+{
+	qsort(dic->data, dic->len, sizeof(tWord), compare);
+
+	// data의 인덱스가 바뀌었으므로 해시 인덱스 무효화
+	free(dic->slots);
+	dic->slots = NULL;
+	dic->nslots = 0;
 }
 
 // 사전을 화면에 출력 ("단어\t빈도" 형식)
@@ -105,13 +443,69 @@ void print_dic(tWordDic *dic)
 	}
 }
 
-// 사전에 할당된 메모리를 해제
-void destroy_dic(tWordDic *dic)
+// 빈도 상위 k개의 단어를 빈도 내림차순으로 출력
+int print_top_dic(tWordDic *dic, int k)
 {
+	// compare_by_freq를 비교 함수로 쓰는 max-heap의 루트는 정렬 순서상 가장 뒤의 단어
+	// 즉, 지금까지 고른 k개 중 가장 덜 빈번한 단어가 루트에 있음
+	HEAP *heap = heap_Create(compare_by_freq);
+	tWord **top;
+	void *ptr;
+	int n;
+
+	if (heap == NULL)
+		return 0;
+
 	for (int i = 0; i < dic->len; i++)
 	{
-		free(dic->data[i].word);
+		tWord *w = &dic->data[i];
+
+		if (heap->last < k)
+		{
+			if (!heap_Insert(heap, w))
+			{
+				heap_Destroy(heap, NULL);
+				return 0;
+			}
+		}
+		else if (k > 0 && compare_by_freq(w, heap->heapArr[0]) < 0)
+		{
+			// 루트보다 앞서는 단어이면 루트를 빼고 교체 (배열 크기는 그대로이므로 실패하지 않음)
+			heap_Delete(heap, &ptr);
+			heap_Insert(heap, w);
+		}
+	}
+
+	// 힙에서는 가장 뒤의 단어부터 나오므로 배열의 뒤에서부터 채움
+	n = heap->last;
+	top = (tWord **)malloc((n > 0 ? n : 1) * sizeof(tWord *));
+	if (top == NULL)
+	{
+		heap_Destroy(heap, NULL);
+		return 0;
 	}
+	for (int i = n - 1; i >= 0; i--)
+	{
+		heap_Delete(heap, &ptr);
+		top[i] = (tWord *)ptr;
+	}
+
+	for (int i = 0; i < n; i++)
+	{
+		printf("%s\t%d\n", top[i]->word, top[i]->freq);
+	}
+
+	free(top);
+	heap_Destroy(heap, NULL);
+	return 1;
+}
+
+// 사전에 할당된 메모리를 해제
+void destroy_dic(tWordDic *dic)
+{
+	// 단어 문자열은 arena에 있으므로 개별 free 없이 한 번에 해제
+	arena_Destroy(dic->words);
+	free(dic->slots);
 	free(dic->data);
 	free(dic);
 }
@@ -134,94 +528,175 @@ int compare_by_freq(const void *n1, const void *n2)
 	return strcmp(w1->word, w2->word);
 }
 
-// 이진탐색 함수 구현
-int binary_search(const void *key, const void *base, size_t nmemb, size_t size,
-				  int (*compare)(const void *, const void *), int *found)
-{
-	int low = 0, high = (int)nmemb - 1;
-	int mid, cmp;
-	while (low <= high)
-	{
-		mid = (low + high) / 2;
-		const void *elem = (const char *)base + mid * size;
-		cmp = compare(key, elem);
-		if (cmp == 0)
-		{
-			*found = 1;
-			return mid;
-		}
-		else if (cmp < 0)
-		{
-			high = mid - 1;
-		}
-		else
-		{
-			low = mid + 1;
-		}
-	}
-	*found = 0;
-	return low;
-}
-
 // 사전을 초기화 (빈 사전을 생성, 메모리 할당)
-// len를 0으로, capacity를 1000으로 초기화
-// return : 구조체 포인터
+// len를 0으로, capacity를 1000으로, growth를 2.0으로 초기화
+// return : 구조체 포인터, 메모리 부족이면 NULL
 tWordDic *create_dic(void)
 {
 	tWordDic *dic = (tWordDic *)malloc(sizeof(tWordDic));
 
+	if (!dic)
+		return NULL;
 	dic->len = 0;
 	dic->capacity = 1000;
 	dic->data = (tWord *)malloc(dic->capacity * sizeof(tWord));
-
+	dic->nslots = 0;
+	dic->slots = NULL;
+	dic->words = arena_Create(0);
+	dic->growth = 2.0;
+	dic->nrealloc = 0;
+	dic->copy_bytes = 0;
+
+	if (!dic->data || !dic->words)
+	{
+		destroy_dic(dic);
+		return NULL;
+	}
 	return dic;
 }
 
+// 경과 시간 측정용 (초)
+static double now_sec(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
 	tWordDic *dic;
-	int option;
-	FILE *fp;
+	int option = -1;
+	int verbose = 0;
+	int nthreads = 1;
+	int topk = -1; // -1이면 사전 전체를 출력
+	double growth = 2.0;
+	double start;
+	char *filename = NULL;
+	TOKENIZER *tok;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-w") == 0)
+			option = SORT_BY_WORD;
+		else if (strcmp(argv[i], "-f") == 0)
+			option = SORT_BY_FREQ;
+		else if (strcmp(argv[i], "-v") == 0)
+			verbose = 1;
+		else if (strcmp(argv[i], "-g") == 0 && i + 1 < argc)
+		{
+			// 1.0 이하이면 배율로 늘지 않으므로 받지 않음
+			char *end;
+			growth = strtod(argv[++i], &end);
+			if (end == argv[i] || *end != '\0' || !(growth > 1.0 && growth <= MAX_GROWTH))
+			{
+				fprintf(stderr, "invalid growth factor : %s\n", argv[i]);
+				filename = NULL;
+				break;
+			}
+		}
+		else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+		{
+			char *end;
+			long n = strtol(argv[++i], &end, 10);
+			if (end == argv[i] || *end != '\0' || n < 1 || n > MAX_THREADS)
+			{
+				fprintf(stderr, "invalid thread count : %s\n", argv[i]);
+				filename = NULL;
+				break;
+			}
+			nthreads = (int)n;
+		}
+		else if (strcmp(argv[i], "-k") == 0 && i + 1 < argc)
+		{
+			// 상위 k개만 출력하는 것은 빈도순 출력에만 의미가 있음
+			// 0이면 아무것도 출력하지 않음 (-f | head -n 0과 같음)
+			char *end;
+			long k = strtol(argv[++i], &end, 10);
+			if (end == argv[i] || *end != '\0' || k < 0 || k > INT_MAX)
+			{
+				fprintf(stderr, "invalid count : %s\n", argv[i]);
+				filename = NULL;
+				break;
+			}
+			topk = (int)k;
+			option = SORT_BY_FREQ;
+		}
+		else if (argv[i][0] == '-')
+		{
+			fprintf(stderr, "unknown option : %s\n", argv[i]);
+			return 1;
+		}
+		else
+			filename = argv[i];
+	}
 
-	if (argc != 3)
+	if (option < 0 || filename == NULL)
 	{
 		fprintf(stderr, "Usage: %s option FILE\n\n", argv[0]);
 		fprintf(stderr, "option\n\t-w\t\tsort by word\n\t-f\t\tsort by frequency\n");
+		fprintf(stderr, "\t-k N\t\tprint only the N most frequent words (N >= 0, implies -f)\n");
+		fprintf(stderr, "\t-g FACTOR\tcapacity growth factor (1.0 < FACTOR <= 16.0, default 2.0)\n");
+		fprintf(stderr, "\t-j N\t\tcount with N threads (1 <= N <= 256, default 1)\n");
+		fprintf(stderr, "\t-v\t\tprint dictionary statistics to stderr\n");
 		return 1;
 	}
 
-	if (strcmp(argv[1], "-w") == 0)
-		option = SORT_BY_WORD;
-	else if (strcmp(argv[1], "-f") == 0)
-		option = SORT_BY_FREQ;
-	else
+	// 사전 초기화
+	if ((dic = create_dic()) == NULL)
 	{
-		fprintf(stderr, "unknown option : %s\n", argv[1]);
+		fprintf(stderr, "out of memory\n");
 		return 1;
 	}
-
-	// 사전 초기화
-	dic = create_dic();
+	dic->growth = growth;
 
 	// 입력 파일 열기
-	if ((fp = fopen(argv[2], "r")) == NULL)
+	if ((tok = tok_Open(filename)) == NULL)
 	{
-		fprintf(stderr, "cannot open file : %s\n", argv[2]);
+		fprintf(stderr, "cannot open file : %s\n", filename);
 		return 1;
 	}
 
+	// 파일 크기로부터 추정한 단어 수만큼 미리 확보 (geometric growth일 때만)
+	if (growth > 1.0)
+		reserve_dic(dic, size_hint_dic(tok->size));
+
 	// 입력 파일로부터 단어와 빈도를 사전에 저장
-	word_count(fp, dic);
+	start = now_sec();
+	if (!word_count_parallel(tok, dic, nthreads))
+	{
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
 
-	fclose(fp);
+	tok_Close(tok);
 
-	// 정렬 (빈도 내림차순, 빈도가 같은 경우 단어순)
-	if (option == SORT_BY_FREQ)
+	if (verbose)
 	{
-		qsort(dic->data, dic->len, sizeof(tWord), compare_by_freq);
+		fprintf(stderr, "distinct %d, capacity %d, realloc %d, copied %zu bytes\n",
+				dic->len, dic->capacity, dic->nrealloc, dic->copy_bytes);
+		fprintf(stderr, "threads %d, scanner %s, count %.3f sec\n", nthreads, tok_Scanner(), now_sec() - start);
 	}
 
+	// 상위 k개만 필요하면 전체 정렬 없이 힙으로 선택하여 출력
+	if (topk >= 0)
+	{
+		if (!print_top_dic(dic, topk))
+		{
+			fprintf(stderr, "out of memory\n");
+			return 1;
+		}
+		destroy_dic(dic);
+		return 0;
+	}
+
+	// 정렬 (단어순 또는 빈도 내림차순, 빈도가 같은 경우 단어순)
+	if (option == SORT_BY_FREQ)
+		sort_dic(dic, compare_by_freq);
+	else
+		sort_dic(dic, compare_by_word);
+
 	// 사전을 화면에 출력
 	print_dic(dic);
 
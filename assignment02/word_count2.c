@@ -2,6 +2,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "tokenizer.h"
+#include "arena.h"
+
 #define SORT_BY_WORD 0
 #define SORT_BY_FREQ 1
 
@@ -15,14 +18,18 @@ typedef struct node
 {
     tWord *dataPtr;
     struct node *link;
-    struct node *link2;
+    struct node *link2; // 같은 빈도 bucket 안의 다음 노드 (단어 순)
+    struct node *prev2; // 같은 빈도 bucket 안의 이전 노드
 } NODE;
 
 typedef struct
 {
     int count;
     NODE *head;
-    NODE *head2;
+    NODE **bucket; // bucket[f]: 빈도가 f인 노드들의 list (단어 순)
+    NODE **last;   // last[f]: 검색 중 지나온 노드 중 빈도가 f였던 마지막 노드 (bucket 삽입 위치의 힌트)
+    int maxFreq;   // bucket, last 배열의 크기 - 1
+    ARENA *arena;
 } LIST;
 
 LIST *createList(void)
@@ -32,17 +39,25 @@ LIST *createList(void)
         return NULL;
     list->count = 0;
     list->head = NULL;
-    list->head2 = NULL;
+    list->maxFreq = 16;
+    list->bucket = (NODE **)calloc(list->maxFreq + 1, sizeof(NODE *));
+    list->last = (NODE **)calloc(list->maxFreq + 1, sizeof(NODE *));
+    list->arena = arena_Create(0);
+    if (!list->arena || !list->bucket || !list->last)
+    {
+        if (list->arena)
+            arena_Destroy(list->arena);
+        free(list->bucket);
+        free(list->last);
+        free(list);
+        return NULL;
+    }
     return list;
 }
 
-void destroyWord(tWord *pNode)
+void destroyWord(ARENA *arena, tWord *pNode)
 {
-    if (pNode)
-    {
-        free(pNode->word);
-        free(pNode);
-    }
+    arena_Free(arena, pNode);
 }
 
 void destroyList(LIST *pList)
@@ -52,9 +67,11 @@ void destroyList(LIST *pList)
     {
         NODE *temp = current;
         current = current->link;
-        destroyWord(temp->dataPtr);
         free(temp);
     }
+    arena_Destroy(pList->arena);
+    free(pList->bucket);
+    free(pList->last);
     free(pList);
 }
 
@@ -65,6 +82,7 @@ static int _search(LIST *pList, NODE **pPre, NODE **pLoc, tWord *pArgu)
 
     while (*pLoc && strcmp((*pLoc)->dataPtr->word, pArgu->word) < 0)
     {
+        pList->last[(*pLoc)->dataPtr->freq] = *pLoc;
         *pPre = *pLoc;
         *pLoc = (*pLoc)->link;
     }
@@ -75,6 +93,68 @@ static int _search(LIST *pList, NODE **pPre, NODE **pLoc, tWord *pArgu)
     return 0;
 }
 
+// 빈도가 바뀔 때마다 노드를 해당 bucket으로 옮겨 빈도 순서를 유지
+// 연결: bucket 안에서 단어 순 위치를 찾아 삽입, 필요하면 bucket 배열을 늘림
+// 방금 _search가 지나온 last[freq]가 아직 같은 bucket에 있고 앞선 단어이면 거기서부터 찾음
+static int _link_bucket(LIST *pList, NODE *pLoc)
+{
+    int freq = pLoc->dataPtr->freq;
+    NODE *pPre = NULL;
+    NODE *cur;
+
+    if (freq > pList->maxFreq)
+    {
+        int newMax = pList->maxFreq * 2;
+        while (newMax < freq)
+            newMax *= 2;
+        NODE **newBucket = (NODE **)realloc(pList->bucket, (newMax + 1) * sizeof(NODE *));
+        if (newBucket)
+            pList->bucket = newBucket;
+        NODE **newLast = (NODE **)realloc(pList->last, (newMax + 1) * sizeof(NODE *));
+        if (newLast)
+            pList->last = newLast;
+        if (!newBucket || !newLast)
+            return 0;
+        memset(newBucket + pList->maxFreq + 1, 0, (newMax - pList->maxFreq) * sizeof(NODE *));
+        memset(newLast + pList->maxFreq + 1, 0, (newMax - pList->maxFreq) * sizeof(NODE *));
+        pList->maxFreq = newMax;
+    }
+
+    NODE *hint = pList->last[freq];
+    if (hint && hint != pLoc && hint->dataPtr->freq == freq &&
+        strcmp(hint->dataPtr->word, pLoc->dataPtr->word) < 0)
+        pPre = hint;
+
+    cur = pPre ? pPre->link2 : pList->bucket[freq];
+    while (cur && strcmp(cur->dataPtr->word, pLoc->dataPtr->word) < 0)
+    {
+        pPre = cur;
+        cur = cur->link2;
+    }
+
+    pLoc->prev2 = pPre;
+    pLoc->link2 = cur;
+    if (cur)
+        cur->prev2 = pLoc;
+    if (pPre)
+        pPre->link2 = pLoc;
+    else
+        pList->bucket[freq] = pLoc;
+    return 1;
+}
+
+// 해제: 이중 연결이므로 O(1)
+static void _unlink_bucket(LIST *pList, NODE *pLoc)
+{
+    if (pLoc->prev2)
+        pLoc->prev2->link2 = pLoc->link2;
+    else
+        pList->bucket[pLoc->dataPtr->freq] = pLoc->link2;
+    if (pLoc->link2)
+        pLoc->link2->prev2 = pLoc->prev2;
+    pLoc->link2 = pLoc->prev2 = NULL;
+}
+
 static int _insert(LIST *pList, NODE *pPre, tWord *dataInPtr)
 {
     NODE *newNode = (NODE *)malloc(sizeof(NODE));
@@ -83,7 +163,11 @@ static int _insert(LIST *pList, NODE *pPre, tWord *dataInPtr)
 
     newNode->dataPtr = dataInPtr;
     newNode->link = NULL;
-    newNode->link2 = NULL;
+    if (!_link_bucket(pList, newNode))
+    {
+        free(newNode);
+        return 0;
+    }
 
     if (!pPre)
     {
@@ -106,7 +190,15 @@ int addNode(LIST *pList, tWord *dataInPtr)
 
     if (found)
     {
+        _unlink_bucket(pList, pLoc);
         pLoc->dataPtr->freq++;
+        if (!_link_bucket(pList, pLoc))
+        {
+            // bucket 배열을 늘리지 못하면 빈도를 되돌림
+            pLoc->dataPtr->freq--;
+            _link_bucket(pList, pLoc);
+            return 0;
+        }
         return 2;
     }
     else
@@ -115,50 +207,6 @@ int addNode(LIST *pList, tWord *dataInPtr)
     }
 }
 
-static int _search_by_freq(LIST *pList, NODE **pPre, NODE **pLoc, tWord *pArgu)
-{
-    *pPre = NULL;
-    *pLoc = pList->head2;
-
-    while (*pLoc && ((*pLoc)->dataPtr->freq > pArgu->freq ||
-                     ((*pLoc)->dataPtr->freq == pArgu->freq &&
-                      strcmp((*pLoc)->dataPtr->word, pArgu->word) < 0)))
-    {
-        *pPre = *pLoc;
-        *pLoc = (*pLoc)->link2;
-    }
-
-    return 0;
-}
-
-static void _link_by_freq(LIST *pList, NODE *pPre, NODE *pLoc)
-{
-    if (!pPre)
-    {
-        pLoc->link2 = pList->head2;
-        pList->head2 = pLoc;
-    }
-    else
-    {
-        pLoc->link2 = pPre->link2;
-        pPre->link2 = pLoc;
-    }
-}
-
-void connect_by_frequency(LIST *list)
-{
-    list->head2 = NULL;
-    NODE *cur = list->head;
-
-    while (cur)
-    {
-        NODE *pPre, *pLoc;
-        _search_by_freq(list, &pPre, &pLoc, cur->dataPtr);
-        _link_by_freq(list, pPre, cur);
-        cur = cur->link;
-    }
-}
-
 void print_dic(LIST *pList)
 {
     NODE *cur = pList->head;
@@ -169,27 +217,28 @@ void print_dic(LIST *pList)
     }
 }
 
+// bucket이 항상 유지되므로 따로 정렬하지 않고 높은 빈도부터 출력
 void print_dic_by_freq(LIST *pList)
 {
-    NODE *cur = pList->head2;
-    while (cur)
+    for (int freq = pList->maxFreq; freq > 0; freq--)
     {
-        printf("%s\t%d\n", cur->dataPtr->word, cur->dataPtr->freq);
-        cur = cur->link2;
+        NODE *cur = pList->bucket[freq];
+        while (cur)
+        {
+            printf("%s\t%d\n", cur->dataPtr->word, cur->dataPtr->freq);
+            cur = cur->link2;
+        }
     }
 }
 
-tWord *createWord(char *word)
+tWord *createWord(ARENA *arena, char *word)
 {
-    tWord *p = (tWord *)malloc(sizeof(tWord));
+    size_t len = strlen(word);
+    tWord *p = (tWord *)arena_Alloc(arena, sizeof(tWord) + len + 1);
     if (!p)
         return NULL;
-    p->word = strdup(word);
-    if (!p->word)
-    {
-        free(p);
-        return NULL;
-    }
+    p->word = (char *)(p + 1);
+    memcpy(p->word, word, len + 1);
     p->freq = 1;
     return p;
 }
@@ -215,8 +264,8 @@ int main(int argc, char **argv)
 {
     LIST *list;
     int option;
-    FILE *fp;
-    char word[100];
+    TOKENIZER *tok;
+    char *word;
     tWord *pWord;
     int ret;
 
@@ -244,15 +293,15 @@ int main(int argc, char **argv)
         return 100;
     }
 
-    if ((fp = fopen(argv[2], "r")) == NULL)
+    if ((tok = tok_Open(argv[2])) == NULL)
     {
         fprintf(stderr, "cannot open file : %s\n", argv[2]);
         return 2;
     }
 
-    while (fscanf(fp, "%s", word) != EOF)
+    while ((word = tok_NextWord(tok)) != NULL)
     {
-        pWord = createWord(word);
+        pWord = createWord(list->arena, word);
         if (!pWord)
             continue;
 
@@ -260,11 +309,11 @@ int main(int argc, char **argv)
 
         if (ret == 0 || ret == 2)
         {
-            destroyWord(pWord);
+            destroyWord(list->arena, pWord);
         }
     }
 
-    fclose(fp);
+    tok_Close(tok);
 
     if (option == SORT_BY_WORD)
     {
@@ -272,7 +321,6 @@ int main(int argc, char **argv)
     }
     else
     {
-        connect_by_frequency(list);
         print_dic_by_freq(list);
     }
 
@@ -1,8 +1,12 @@
 #include <stdio.h>
 #include <stdlib.h> // malloc
-#include <string.h> // strdup, strcmp
+#include <string.h> // strlen, memcpy, strcmp
 #include <ctype.h>	// toupper
 
+#include "tokenizer.h"
+#include "arena.h"
+#include "batch.h"
+
 #define QUIT 1
 #define FORWARD_PRINT 2
 #define BACKWARD_PRINT 3
@@ -32,6 +36,8 @@ typedef struct
 	int count;
 	NODE *head;
 	NODE *rear;
+	ARENA *arena; // 단어 구조체와 문자열 저장 공간 (destroyList에서 한꺼번에 해제)
+	NODE *finger; // 마지막으로 찾거나 삽입한 노드 (탐색 시작 위치, NULL이면 head부터)
 } LIST;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -90,6 +96,7 @@ static void _delete(LIST *pList, NODE *pPre, NODE *pLoc, tWord **dataOutPtr);
 
 // internal search function
 // searches list and passes back address of node containing target and its logical predecessor
+// finger에서 시작하여 앞(rlink) 또는 뒤(llink)로 탐색 (거의 정렬된 입력은 상수 시간)
 // for addNode, removeNode, searchNode functions
 // return	1 found
 // 			0 not found
@@ -99,20 +106,20 @@ static int _search(LIST *pList, NODE **pPre, NODE **pLoc, tWord *pArgu);
 // 단어 구조체를 위한 메모리를 할당하고 word, freq 초기화// return	word structure pointer
 // return	할당된 단어 구조체에 대한 pointer
 //			NULL if overflow
-tWord *createWord(char *word);
+// 단어 구조체와 문자열은 arena에서 한 번에 할당
+tWord *createWord(ARENA *arena, char *word);
 
 //  단어 구조체에 할당된 메모리를 해제
-// for destroyList function
-void destroyWord(tWord *pNode);
+// 가장 최근에 할당한 단어(중복되어 삽입되지 않은 단어)만 즉시 반환되고,
+// 나머지는 destroyList에서 arena와 함께 해제됨
+void destroyWord(ARENA *arena, tWord *pNode);
 
 ////////////////////////////////////////////////////////////////////////////////
-// gets user's input
-int get_action()
+// converts a menu character to an action
+// for get_action and run_batch functions
+int to_action(int ch)
 {
-	char ch;
-	scanf("%c", &ch);
-	ch = toupper(ch);
-	switch (ch)
+	switch (toupper(ch))
 	{
 	case 'Q':
 		return QUIT;
@@ -130,6 +137,14 @@ int get_action()
 	return 0; // undefined action
 }
 
+// gets user's input
+int get_action()
+{
+	char ch;
+	scanf("%c", &ch);
+	return to_action(ch);
+}
+
 // compares two words in word structures
 // for _search function
 // 정렬 기준 : 단어
@@ -152,7 +167,75 @@ void print_word(const tWord *dataPtr)
 void input_word(char *word)
 {
 	fprintf(stderr, "Input a word to find: ");
-	fscanf(stdin, "%s", word);
+	fscanf(stdin, "%99s", word);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 명령 파일의 명령을 차례로 실행 (Q를 만나면 끝), 출력 형식은 메뉴와 같음
+// 연속된 S)earch는 단어 순으로 정렬하여 찾고 (finger 근처의 단어를 연달아 찾음), 결과는 원래 순서대로 출력
+// return	실행한 명령 수
+int run_batch(LIST *list, BATCH *batch)
+{
+	tWord key; // 검색에는 단어만 사용
+	tWord *ptr;
+	int i = 0;
+
+	while (i < batch->n)
+	{
+		BATCH_CMD *cmd = &batch->cmds[i];
+
+		switch (to_action(cmd->action))
+		{
+		case QUIT:
+			return i;
+
+		case FORWARD_PRINT:
+			traverseList(list, print_word);
+			break;
+
+		case BACKWARD_PRINT:
+			traverseListR(list, print_word);
+			break;
+
+		case SEARCH:
+		{
+			int run = batch_SortRun(batch, i);
+
+			for (int k = 0; k < run; k++)
+			{
+				key.word = batch->order[k]->arg;
+				batch->order[k]->result = searchNode(list, &key, &ptr) ? ptr : NULL;
+			}
+			for (int k = i; k < i + run; k++)
+			{
+				if (batch->cmds[k].result)
+					print_word(batch->cmds[k].result);
+				else
+					fprintf(stdout, "%s not found\n", batch->cmds[k].arg);
+			}
+			i += run;
+			continue;
+		}
+
+		case DELETE:
+			key.word = cmd->arg;
+
+			if (removeNode(list, &key, &ptr))
+			{
+				fprintf(stdout, "%s\t%d deleted\n", ptr->word, ptr->freq);
+				destroyWord(list->arena, ptr);
+			}
+			else
+				fprintf(stdout, "%s not found\n", cmd->arg);
+			break;
+
+		case COUNT:
+			fprintf(stdout, "%d\n", countList(list));
+			break;
+		}
+		i++;
+	}
+	return i;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -164,18 +247,35 @@ int main(int argc, char **argv)
 	char word[100];
 	tWord *pWord;
 	int ret;
-	FILE *fp;
+	TOKENIZER *tok;
+	char *token;
+	char *filename = NULL;
+	char *queries = NULL;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-q") == 0 && i + 1 < argc)
+			queries = argv[++i];
+		else if (argv[i][0] == '-' || filename)
+		{
+			filename = NULL;
+			break;
+		}
+		else
+			filename = argv[i];
+	}
 
-	if (argc != 2)
+	if (!filename)
 	{
-		fprintf(stderr, "usage: %s FILE\n", argv[0]);
+		fprintf(stderr, "usage: %s [-q QUERIES] FILE\n", argv[0]);
+		fprintf(stderr, "\t-q\trun the menu commands in QUERIES (S/D/C/P/B/Q) instead of reading stdin\n");
 		return 1;
 	}
 
-	fp = fopen(argv[1], "rt");
-	if (!fp)
+	tok = tok_Open(filename);
+	if (!tok)
 	{
-		fprintf(stderr, "Error: cannot open file [%s]\n", argv[1]);
+		fprintf(stderr, "Error: cannot open file [%s]\n", filename);
 		return 2;
 	}
 
@@ -187,20 +287,42 @@ int main(int argc, char **argv)
 		return 100;
 	}
 
-	while (fscanf(fp, "%s", word) != EOF)
+	while ((token = tok_NextWord(tok)) != NULL)
 	{
-		pWord = createWord(word);
+		pWord = createWord(list->arena, token);
 
 		// 이미 저장된 단어는 빈도 증가
 		ret = addNode(list, pWord);
 
 		if (ret == 0 || ret == 2) // failure or duplicated
 		{
-			destroyWord(pWord);
+			destroyWord(list->arena, pWord);
 		}
 	}
 
-	fclose(fp);
+	tok_Close(tok);
+
+	if (queries)
+	{
+		BATCH *batch = batch_Load(queries, "SD");
+		if (!batch)
+		{
+			fprintf(stderr, "Error: cannot open file [%s]\n", queries);
+			return 2;
+		}
+
+		// 결과는 한꺼번에 출력
+		setvbuf(stdout, NULL, _IOFBF, 1 << 16);
+		double start = batch_Clock();
+		int n = run_batch(list, batch);
+		fflush(stdout);
+		double sec = batch_Clock() - start;
+		fprintf(stderr, "%d queries in %.3f s (%.0f queries/sec)\n", n, sec, n / (sec > 0 ? sec : 1e-9));
+
+		batch_Destroy(batch);
+		destroyList(list);
+		return 0;
+	}
 
 	fprintf(stderr, "Select Q)uit, P)rint, B)ackward print, S)earch, D)elete, C)ount: ");
 
@@ -226,30 +348,30 @@ int main(int argc, char **argv)
 		case SEARCH:
 			input_word(word);
 
-			pWord = createWord(word);
+			pWord = createWord(list->arena, word);
 
 			if (searchNode(list, pWord, &ptr))
 				print_word(ptr);
 			else
 				fprintf(stdout, "%s not found\n", word);
 
-			destroyWord(pWord);
+			destroyWord(list->arena, pWord);
 			break;
 
 		case DELETE:
 			input_word(word);
 
-			pWord = createWord(word);
+			pWord = createWord(list->arena, word);
 
 			if (removeNode(list, pWord, &ptr))
 			{
 				fprintf(stdout, "%s\t%d deleted\n", ptr->word, ptr->freq);
-				destroyWord(ptr);
+				destroyWord(list->arena, ptr);
 			}
 			else
 				fprintf(stdout, "%s not found\n", word);
 
-			destroyWord(pWord);
+			destroyWord(list->arena, pWord);
 			break;
 
 		case COUNT:
@@ -271,6 +393,13 @@ LIST *createList(void)
 		return NULL;
 	pList->count = 0;
 	pList->head = pList->rear = NULL;
+	pList->finger = NULL;
+	pList->arena = arena_Create(0);
+	if (!pList->arena)
+	{
+		free(pList);
+		return NULL;
+	}
 	return pList;
 }
 
@@ -281,10 +410,10 @@ void destroyList(LIST *pList)
 	while (p)
 	{
 		NODE *next = p->rlink;
-		destroyWord(p->dataPtr);
 		free(p);
 		p = next;
 	}
+	arena_Destroy(pList->arena);
 	free(pList);
 }
 
@@ -390,6 +519,7 @@ static int _insert(LIST *pList, NODE *pPre, tWord *dataInPtr)
 		pPre->rlink = pNew;
 	}
 	pList->count++;
+	pList->finger = pNew;
 	return 1;
 }
 
@@ -414,46 +544,67 @@ static void _delete(LIST *pList, NODE *pPre, NODE *pLoc, tWord **dataOutPtr)
 	}
 	pList->count--;
 	*dataOutPtr = pLoc->dataPtr;
+	if (pList->finger == pLoc)
+		pList->finger = pPre;
 	free(pLoc);
 }
 
 // 내부 검색 함수
 static int _search(LIST *pList, NODE **pPre, NODE **pLoc, tWord *pArgu)
 {
-	*pPre = NULL;
-	*pLoc = pList->head;
+	NODE *finger = pList->finger;
+
+	if (finger && compare_by_word(finger->dataPtr, pArgu) > 0)
+	{
+		// finger보다 앞의 단어: finger부터 llink를 따라 뒤로 탐색
+		*pLoc = finger;
+		*pPre = finger->llink;
+		while (*pPre && compare_by_word((*pPre)->dataPtr, pArgu) > 0)
+		{
+			*pLoc = *pPre;
+			*pPre = (*pPre)->llink;
+		}
+		if (*pPre && compare_by_word((*pPre)->dataPtr, pArgu) == 0)
+		{
+			*pLoc = *pPre;
+			*pPre = (*pLoc)->llink;
+			pList->finger = *pLoc;
+			return 1;
+		}
+		return 0;
+	}
+
+	// finger 이후의 단어 (finger가 없으면 head부터): rlink를 따라 앞으로 탐색
+	*pPre = finger ? finger->llink : NULL;
+	*pLoc = finger ? finger : pList->head;
 	while (*pLoc && compare_by_word((*pLoc)->dataPtr, pArgu) < 0)
 	{
 		*pPre = *pLoc;
 		*pLoc = (*pLoc)->rlink;
 	}
 	if (*pLoc && compare_by_word((*pLoc)->dataPtr, pArgu) == 0)
+	{
+		pList->finger = *pLoc;
 		return 1;
+	}
 	return 0;
 }
 
 // 단어 구조체 생성
-tWord *createWord(char *word)
+tWord *createWord(ARENA *arena, char *word)
 {
-	tWord *p = (tWord *)malloc(sizeof(tWord));
+	size_t len = strlen(word);
+	tWord *p = (tWord *)arena_Alloc(arena, sizeof(tWord) + len + 1);
 	if (!p)
 		return NULL;
-	p->word = strdup(word);
-	if (!p->word)
-	{
-		free(p);
-		return NULL;
-	}
+	p->word = (char *)(p + 1);
+	memcpy(p->word, word, len + 1);
 	p->freq = 1;
 	return p;
 }
 
 // 단어 구조체 메모리 해제
-void destroyWord(tWord *pNode)
+void destroyWord(ARENA *arena, tWord *pNode)
 {
-	if (pNode)
-	{
-		free(pNode->word);
-		free(pNode);
-	}
+	arena_Free(arena, pNode);
 }
@@ -1,187 +1,453 @@
-#include <stdlib.h> // malloc
+#include <stdlib.h> // malloc, free
 
 #include "adt_dlist.h"
 
+// next node of node at level k (node NULL: head of the list)
+static inline NODE *_next(LIST *pList, NODE *node, int k)
+{
+	if (k == 0)
+		return node ? node->rlink : pList->head;
+	return node ? node->forward[k - 1] : pList->forward[k - 1];
+}
+
+static inline void _setNext(LIST *pList, NODE *node, int k, NODE *next)
+{
+	if (k == 0)
+	{
+		if (node)
+			node->rlink = next;
+		else
+			pList->head = next;
+	}
+	else if (node)
+		node->forward[k - 1] = next;
+	else
+		pList->forward[k - 1] = next;
+}
+
+// level of a new node: 1 + 1/4 확률로 하나씩 증가 (xorshift64)
+static int _randomLevel(LIST *pList)
+{
+	int level = 1;
+	while (level < LIST_MAX_LEVEL)
+	{
+		pList->seed ^= pList->seed << 13;
+		pList->seed ^= pList->seed >> 7;
+		pList->seed ^= pList->seed << 17;
+		if (pList->seed & 3)
+			break;
+		level++;
+	}
+	return level;
+}
+
 // internal insert function
-// inserts data into list
+// inserts data into list after update[0] and links it into levels 1 .. level - 1 after update[k]
 // for addNode function
 // return	1 if successful
 // 			0 if memory overflow
-static int _insert(LIST *pList, NODE *pPre, void *dataInPtr)
-{
-    NODE *newNode = (NODE *)malloc(sizeof(NODE));
-    if (!newNode)
-        return 0;
-    newNode->dataPtr = dataInPtr;
-    if (!pPre)
-    {
-        // insert at head
-        newNode->llink = NULL;
-        newNode->rlink = pList->head;
-        if (pList->head)
-            pList->head->llink = newNode;
-        pList->head = newNode;
-        if (!pList->rear)
-            pList->rear = newNode;
-    }
-    else
-    {
-        newNode->rlink = pPre->rlink;
-        newNode->llink = pPre;
-        if (pPre->rlink)
-            pPre->rlink->llink = newNode;
-        pPre->rlink = newNode;
-        if (pList->rear == pPre)
-            pList->rear = newNode;
-    }
-    pList->count++;
-    return 1;
+static int _insert(LIST *pList, NODE **update, int level, void *dataInPtr)
+{
+	NODE *pPre = update[0];
+	NODE *newNode;
+
+	if (pList->pool)
+		newNode = (NODE *)pool_Alloc(pList->pool);
+	else
+		newNode = (NODE *)malloc(sizeof(NODE));
+	if (!newNode)
+		return 0;
+	newNode->forward = NULL;
+	if (level > 1)
+	{
+		size_t size = (level - 1) * sizeof(NODE *);
+		newNode->forward = (NODE **)(pList->towers ? arena_Alloc(pList->towers, size) : malloc(size));
+		if (!newNode->forward)
+		{
+			if (pList->pool)
+				pool_Free(pList->pool, newNode);
+			else
+				free(newNode);
+			return 0;
+		}
+	}
+	newNode->dataPtr = dataInPtr;
+	if (!pPre)
+	{
+		// insert at head
+		newNode->llink = NULL;
+		newNode->rlink = pList->head;
+		if (pList->head)
+			pList->head->llink = newNode;
+		pList->head = newNode;
+		if (!pList->rear)
+			pList->rear = newNode;
+	}
+	else
+	{
+		newNode->rlink = pPre->rlink;
+		newNode->llink = pPre;
+		if (pPre->rlink)
+			pPre->rlink->llink = newNode;
+		pPre->rlink = newNode;
+		if (pList->rear == pPre)
+			pList->rear = newNode;
+	}
+
+	// 새 level은 head에서 바로 연결
+	for (int k = pList->level; k < level; k++)
+		update[k] = NULL;
+	if (level > pList->level)
+		pList->level = level;
+	for (int k = 1; k < level; k++)
+	{
+		newNode->forward[k - 1] = _next(pList, update[k], k);
+		_setNext(pList, update[k], k, newNode);
+	}
+
+	pList->count++;
+	pList->finger = newNode;
+	return 1;
 }
 
 // internal delete function
 // deletes data from list and saves the (deleted) data to dataOutPtr
+// update[k] is the predecessor of pLoc at level k (as filled by _search)
 // for removeNode function
-static void _delete(LIST *pList, NODE *pPre, NODE *pLoc, void **dataOutPtr)
-{
-    if (!pLoc)
-        return;
-    if (!pPre)
-    {
-        pList->head = pLoc->rlink;
-        if (pList->head)
-            pList->head->llink = NULL;
-    }
-    else
-    {
-        pPre->rlink = pLoc->rlink;
-        if (pLoc->rlink)
-            pLoc->rlink->llink = pPre;
-    }
-    if (pList->rear == pLoc)
-        pList->rear = pPre;
-    *dataOutPtr = pLoc->dataPtr;
-    free(pLoc);
-    pList->count--;
+static void _delete(LIST *pList, NODE **update, NODE *pLoc, void **dataOutPtr)
+{
+	NODE *pPre = update[0];
+
+	if (!pLoc)
+		return;
+
+	// level 1.. 에서 pLoc을 가리키는 링크를 건너뛰도록 변경 (level 1 노드는 해당 없음)
+	for (int k = 1; pLoc->forward && k < pList->level; k++)
+	{
+		if (_next(pList, update[k], k) != pLoc)
+			break;
+		_setNext(pList, update[k], k, pLoc->forward[k - 1]);
+	}
+	while (pList->level > 1 && !pList->forward[pList->level - 2])
+		pList->level--;
+
+	if (!pPre)
+	{
+		pList->head = pLoc->rlink;
+		if (pList->head)
+			pList->head->llink = NULL;
+	}
+	else
+	{
+		pPre->rlink = pLoc->rlink;
+		if (pLoc->rlink)
+			pLoc->rlink->llink = pPre;
+	}
+	if (pList->rear == pLoc)
+		pList->rear = pPre;
+	if (pList->finger == pLoc)
+		pList->finger = pPre;
+	*dataOutPtr = pLoc->dataPtr;
+	if (pList->towers)
+		arena_Free(pList->towers, pLoc->forward);
+	else
+		free(pLoc->forward);
+	if (pList->pool)
+		pool_Free(pList->pool, pLoc);
+	else
+		free(pLoc);
+	pList->count--;
+}
+
+// internal function
+// drops the snapshot made by freezeList (called before data is added or removed)
+static void _thaw(LIST *pList)
+{
+	eytz_Destroy(pList->frozen);
+	pList->frozen = NULL;
 }
 
 LIST *createList(int (*compare)(const void *, const void *))
 {
-    LIST *list = (LIST *)malloc(sizeof(LIST));
-    if (!list)
-        return NULL;
-    list->count = 0;
-    list->head = list->rear = NULL;
-    list->compare = compare;
-    return list;
+	return createListEx(compare, 0);
+}
+
+LIST *createListEx(int (*compare)(const void *, const void *), int flags)
+{
+	LIST *list = (LIST *)malloc(sizeof(LIST));
+	if (!list)
+		return NULL;
+	list->count = 0;
+	list->head = list->rear = NULL;
+	list->compare = compare;
+	list->pool = NULL;
+	list->towers = NULL;
+	list->level = 1;
+	for (int k = 0; k < LIST_MAX_LEVEL - 1; k++)
+		list->forward[k] = NULL;
+	list->seed = 0x9E3779B97F4A7C15ULL;
+	list->finger = NULL;
+	list->fingerSkip = 0;
+	list->fingerMiss = 0;
+	list->frozen = NULL;
+	if (flags & LIST_POOL)
+	{
+		list->pool = pool_Create(sizeof(NODE), 0);
+		list->towers = arena_Create(0);
+		if (!list->pool || !list->towers)
+		{
+			pool_Destroy(list->pool);
+			arena_Destroy(list->towers);
+			free(list);
+			return NULL;
+		}
+	}
+	return list;
 }
 
 // internal search function
-// searches list and passes back address of node containing target and its logical predecessor
+// searches list from the top level down and passes back address of node containing target
+// and its logical predecessor at every level (update[0] is the level-0 predecessor, NULL: head)
 // for addNode, removeNode, searchNode functions
 // return	1 found
 // 			0 not found
-static int _search(LIST *pList, NODE **pPre, NODE **pLoc, void *pArgu)
-{
-    NODE *pre = NULL;
-    NODE *loc = pList->head;
-    while (loc)
-    {
-        int cmp = pList->compare(pArgu, loc->dataPtr);
-        if (cmp == 0)
-            break;
-        if (cmp < 0)
-            break;
-        pre = loc;
-        loc = loc->rlink;
-    }
-    *pPre = pre;
-    *pLoc = loc;
-    return (loc && pList->compare(pArgu, loc->dataPtr) == 0) ? 1 : 0;
+static int _search(LIST *pList, NODE **update, NODE **pLoc, void *pArgu)
+{
+	NODE *pre = NULL;
+	NODE *loc = NULL;
+	NODE *stop = NULL; // 위 level에서 멈춘 노드 (다시 비교하지 않음)
+	int stopCmp = 1;
+	int cmp = 1;
+
+	for (int k = pList->level - 1; k >= 0; k--)
+	{
+		while ((loc = _next(pList, pre, k)) != NULL)
+		{
+			if (loc == stop)
+			{
+				cmp = stopCmp;
+				break;
+			}
+			cmp = pList->compare(pArgu, loc->dataPtr);
+			if (cmp <= 0)
+				break;
+			pre = loc;
+		}
+		stop = loc;
+		stopCmp = cmp;
+		update[k] = pre;
+	}
+	*pLoc = loc;
+	return (loc && cmp == 0) ? 1 : 0;
+}
+
+// internal search function around the finger
+// looks at most LIST_FINGER_STEPS nodes forward (rlink) or backward (llink) from the finger
+// passes back the node containing target (or its successor) and its level-0 predecessor
+// return	1 found
+// 			0 not found (pPre, pLoc give the position)
+// 			-1 target is outside the window or the finger is backing off (use _search)
+// after n misses in a row the finger is skipped for LIST_FINGER_BACKOFF * 2^(n - 1) searches
+static int _searchFinger(LIST *pList, NODE **pPre, NODE **pLoc, void *pArgu)
+{
+	NODE *pre, *loc;
+	int cmp;
+
+	if (!pList->finger)
+		return -1;
+	if (pList->fingerSkip > 0)
+	{
+		pList->fingerSkip--;
+		return -1;
+	}
+	loc = pList->finger;
+	cmp = pList->compare(pArgu, loc->dataPtr);
+	if (cmp == 0)
+	{
+		*pPre = loc->llink;
+		*pLoc = loc;
+		pList->fingerMiss = 0;
+		return 1;
+	}
+
+	if (cmp > 0)
+	{
+		pre = loc;
+		loc = loc->rlink;
+		for (int i = 0; i < LIST_FINGER_STEPS; i++)
+		{
+			if (!loc || (cmp = pList->compare(pArgu, loc->dataPtr)) <= 0)
+			{
+				pList->fingerMiss = 0;
+				*pPre = pre;
+				*pLoc = loc;
+				return (loc && cmp == 0) ? 1 : 0;
+			}
+			pre = loc;
+			loc = loc->rlink;
+		}
+	}
+	else
+	{
+		pre = loc->llink;
+		for (int i = 0; i < LIST_FINGER_STEPS; i++)
+		{
+			if (!pre || (cmp = pList->compare(pArgu, pre->dataPtr)) >= 0)
+			{
+				pList->fingerMiss = 0;
+				if (pre && cmp == 0)
+				{
+					*pPre = pre->llink;
+					*pLoc = pre;
+					return 1;
+				}
+				*pPre = pre;
+				*pLoc = loc;
+				return 0;
+			}
+			loc = pre;
+			pre = pre->llink;
+		}
+	}
+	// 연달아 빗나갈수록 finger를 쓰지 않는 기간을 2배씩 늘림 (무작위 입력에서는 거의 꺼짐)
+	if (pList->fingerMiss < LIST_FINGER_MAX_MISS)
+		pList->fingerMiss++;
+	pList->fingerSkip = LIST_FINGER_BACKOFF << (pList->fingerMiss - 1);
+	return -1;
 }
 
 void destroyList(LIST *pList, void (*callback)(void *))
 {
-    if (!pList)
-        return;
-    NODE *curr = pList->head;
-    while (curr)
-    {
-        NODE *next = curr->rlink;
-        if (callback)
-            callback(curr->dataPtr);
-        free(curr);
-        curr = next;
-    }
-    free(pList);
+	if (!pList)
+		return;
+	NODE *curr = pList->head;
+	// pool에서 할당한 노드와 forward 배열은 pool_Destroy, arena_Destroy에서 한꺼번에 해제
+	if (pList->pool && !callback)
+		curr = NULL;
+	while (curr)
+	{
+		NODE *next = curr->rlink;
+		if (callback)
+			callback(curr->dataPtr);
+		if (!pList->pool)
+		{
+			free(curr->forward);
+			free(curr);
+		}
+		curr = next;
+	}
+	_thaw(pList);
+	pool_Destroy(pList->pool);
+	arena_Destroy(pList->towers);
+	free(pList);
 }
 
 int addNode(LIST *pList, void *dataInPtr, void (*callback)(const void *))
 {
-    if (!pList || !dataInPtr)
-        return 0;
-    NODE *pre = NULL, *loc = NULL;
-    if (_search(pList, &pre, &loc, dataInPtr))
-    {
-        // duplicate
-        if (callback)
-            callback(loc->dataPtr);
-        return 2;
-    }
-    // insert
-    return _insert(pList, pre, dataInPtr);
+	if (!pList || !dataInPtr)
+		return 0;
+	NODE *update[LIST_MAX_LEVEL], *loc = NULL;
+	int level = _randomLevel(pList);
+	// finger 근처이면 level 0의 위치만으로 충분 (level 1 노드이거나 중복인 경우)
+	int found = _searchFinger(pList, &update[0], &loc, dataInPtr);
+	if (found < 0 || (found == 0 && level > 1))
+		found = _search(pList, update, &loc, dataInPtr);
+	if (found)
+	{
+		// duplicate
+		if (callback)
+			callback(loc->dataPtr);
+		pList->finger = loc;
+		return 2;
+	}
+	// insert
+	_thaw(pList);
+	return _insert(pList, update, level, dataInPtr);
 }
 
 int removeNode(LIST *pList, void *keyPtr, void **dataOutPtr)
 {
-    if (!pList)
-        return 0;
-    NODE *pre = NULL, *loc = NULL;
-    if (!_search(pList, &pre, &loc, keyPtr))
-        return 0;
-    _delete(pList, pre, loc, dataOutPtr);
-    return 1;
+	if (!pList)
+		return 0;
+	NODE *update[LIST_MAX_LEVEL], *loc = NULL;
+	// level 1 노드는 level 0의 predecessor만 있으면 삭제할 수 있음
+	int found = _searchFinger(pList, &update[0], &loc, keyPtr);
+	if (found < 0 || (found == 1 && loc->forward))
+		found = _search(pList, update, &loc, keyPtr);
+	if (!found)
+		return 0;
+	_thaw(pList);
+	_delete(pList, update, loc, dataOutPtr);
+	return 1;
 }
 
 int searchNode(LIST *pList, void *pArgu, void **dataOutPtr)
 {
-    if (!pList)
-        return 0;
-    NODE *pre = NULL, *loc = NULL;
-    if (_search(pList, &pre, &loc, pArgu))
-    {
-        if (dataOutPtr)
-            *dataOutPtr = loc->dataPtr;
-        return 1;
-    }
-    return 0;
+	if (!pList)
+		return 0;
+	if (pList->frozen)
+	{
+		void *found = eytz_Search(pList->frozen, pArgu);
+		if (found && dataOutPtr)
+			*dataOutPtr = found;
+		return found ? 1 : 0;
+	}
+	NODE *update[LIST_MAX_LEVEL], *loc = NULL;
+	int found = _searchFinger(pList, &update[0], &loc, pArgu);
+	if (found < 0)
+		found = _search(pList, update, &loc, pArgu);
+	if (found)
+	{
+		pList->finger = loc;
+		if (dataOutPtr)
+			*dataOutPtr = loc->dataPtr;
+		return 1;
+	}
+	return 0;
+}
+
+int freezeList(LIST *pList, unsigned long long (*key)(const void *))
+{
+	if (!pList)
+		return 0;
+	_thaw(pList);
+	void **sorted = (void **)malloc((pList->count + 1) * sizeof(void *));
+	if (!sorted)
+		return 0;
+	int n = 0;
+	for (NODE *curr = pList->head; curr; curr = curr->rlink)
+		sorted[n++] = curr->dataPtr;
+	pList->frozen = eytz_Create(sorted, n, pList->compare, key);
+	free(sorted);
+	return pList->frozen ? 1 : 0;
 }
 
 int countList(LIST *pList)
 {
-    return pList ? pList->count : 0;
+	return pList ? pList->count : 0;
 }
 
 int emptyList(LIST *pList)
 {
-    return (pList && pList->count == 0) ? 1 : 0;
+	return (pList && pList->count == 0) ? 1 : 0;
 }
 
 void traverseList(LIST *pList, void (*callback)(const void *))
 {
-    NODE *curr = pList->head;
-    while (curr)
-    {
-        callback(curr->dataPtr);
-        curr = curr->rlink;
-    }
+	NODE *curr = pList->head;
+	while (curr)
+	{
+		callback(curr->dataPtr);
+		curr = curr->rlink;
+	}
 }
 
 void traverseListR(LIST *pList, void (*callback)(const void *))
 {
-    NODE *curr = pList->rear;
-    while (curr)
-    {
-        callback(curr->dataPtr);
-        curr = curr->llink;
-    }
+	NODE *curr = pList->rear;
+	while (curr)
+	{
+		callback(curr->dataPtr);
+		curr = curr->llink;
+	}
 }
\ No newline at end of file
@@ -1,11 +1,23 @@
 
+#include "pool.h"
+#include "arena.h"
+#include "eytz.h"
+
 ////////////////////////////////////////////////////////////////////////////////
 // LIST type definition
+// 정렬된 이중 연결 리스트 + skip list 인덱스
+// level 0은 llink/rlink 리스트 그대로이고, level 1 이상은 일부 노드(확률 1/4씩 감소)만 연결
+#define LIST_MAX_LEVEL 16 // 4^16개 노드까지 O(log n) 탐색
+#define LIST_FINGER_STEPS 8 // finger에서 앞뒤로 살펴보는 최대 노드 수
+#define LIST_FINGER_BACKOFF 8 // finger가 빗나가면 다음 8번의 탐색은 바로 skip list로
+#define LIST_FINGER_MAX_MISS 8 // 연속으로 빗나간 횟수의 상한 (skip 기간은 최대 8 << 7 = 1024번)
+
 typedef struct node
 {
 	void *dataPtr;
 	struct node *llink;
 	struct node *rlink;
+	struct node **forward; // level 1.. 의 다음 노드 (forward[k - 1]), level 0만 있는 노드는 NULL
 } NODE;
 
 typedef struct
@@ -14,8 +26,20 @@ typedef struct
 	NODE *head;
 	NODE *rear;
 	int (*compare)(const void *, const void *); // used in _search function
+	POOL *pool; // node allocator (LIST_POOL), NULL if nodes are malloc'd
+	int level; // 사용 중인 level 수 (1 이상)
+	NODE *forward[LIST_MAX_LEVEL - 1]; // level 1.. 의 첫 노드
+	ARENA *towers; // LIST_POOL일 때 forward 배열 저장 공간 (destroyList에서 한꺼번에 해제)
+	unsigned long long seed; // level을 정하는 난수 상태
+	NODE *finger; // 마지막으로 찾거나 삽입한 노드 (근처의 키는 skip list 대신 이웃을 따라 탐색)
+	int fingerSkip; // finger가 빗나간 후 finger를 쓰지 않을 남은 탐색 횟수 (무작위 입력에서의 비용 제한)
+	int fingerMiss; // finger가 연속으로 빗나간 횟수 (맞으면 0)
+	EYTZ *frozen; // freezeList로 만든 읽기 전용 snapshot (데이터가 추가/삭제되면 NULL)
 } LIST;
 
+// createListEx flags
+#define LIST_POOL 0x1 // 노드를 slab pool에서 할당: 연속된 메모리, destroyList는 slab 단위로 해제
+
 ////////////////////////////////////////////////////////////////////////////////
 // function declarations
 
@@ -24,7 +48,12 @@ typedef struct
 // 			NULL if overflow
 LIST *createList(int (*compare)(const void *, const void *));
 
+// Same as createList, with options
+// flags	0 or LIST_POOL
+LIST *createListEx(int (*compare)(const void *, const void *), int flags);
+
 //  이름 리스트에 할당된 메모리를 해제 (head node, data node)
+// callback이 NULL이면 데이터는 해제하지 않음 (호출한 쪽에서 한꺼번에 해제하는 경우)
 void destroyList(LIST *pList, void (*callback)(void *));
 
 // Inserts data into list
@@ -46,6 +75,13 @@ int removeNode(LIST *pList, void *keyPtr, void **dataOutPtr);
 //			0 not found
 int searchNode(LIST *pList, void *pArgu, void **dataOutPtr);
 
+// Makes a read-only snapshot of the list in a contiguous array (eytz.h) for searchNode
+// 리스트는 그대로 남고, 이후 addNode로 데이터가 추가되거나 removeNode로 삭제되면 snapshot은 버려짐
+//	key	optional order-preserving key of data (see eytz_Create), NULL: compare only
+//	return	1 successful
+//			0 overflow (searchNode는 리스트를 그대로 사용)
+int freezeList(LIST *pList, unsigned long long (*key)(const void *));
+
 // returns number of nodes in list
 int countList(LIST *pList);
 
@@ -0,0 +1,338 @@
+#include <stdlib.h> // malloc, realloc, free
+#include <string.h> // memmove, memcpy
+
+#include "adt_ulist.h"
+
+static NODE *_newNode(LIST *pList)
+{
+	NODE *node;
+	if (pList->pool)
+		node = (NODE *)pool_Alloc(pList->pool);
+	else
+		node = (NODE *)malloc(sizeof(NODE));
+	if (node)
+		node->count = 0;
+	return node;
+}
+
+static void _freeNode(LIST *pList, NODE *node)
+{
+	if (pList->pool)
+		pool_Free(pList->pool, node);
+	else
+		free(node);
+}
+
+// inserts node into dir at index d
+// return	1 if successful
+// 			0 if memory overflow
+static int _dirInsert(LIST *pList, int d, NODE *node)
+{
+	if (pList->ndir == pList->dirCapacity)
+	{
+		int capacity = pList->dirCapacity ? pList->dirCapacity * 2 : 16;
+		NODE **dir = (NODE **)realloc(pList->dir, capacity * sizeof(NODE *));
+		if (!dir)
+			return 0;
+		pList->dir = dir;
+		pList->dirCapacity = capacity;
+	}
+	memmove(&pList->dir[d + 1], &pList->dir[d], (pList->ndir - d) * sizeof(NODE *));
+	pList->dir[d] = node;
+	pList->ndir++;
+	return 1;
+}
+
+// removes index d from dir (and frees the node)
+static void _dirRemove(LIST *pList, int d)
+{
+	_freeNode(pList, pList->dir[d]);
+	memmove(&pList->dir[d], &pList->dir[d + 1], (pList->ndir - d - 1) * sizeof(NODE *));
+	pList->ndir--;
+}
+
+// internal search function
+// finds the node whose last data is the first one >= target (binary search over dir),
+// then the first slot >= target in that node (binary search in the node)
+// passes back node index and slot index (the insert position if not found)
+// for addNode, removeNode, searchNode functions
+// return	1 found
+// 			0 not found
+static int _search(LIST *pList, int *pNode, int *pSlot, void *pArgu)
+{
+	int lo = 0, hi = pList->ndir;
+	NODE *node;
+
+	if (pList->ndir == 0)
+	{
+		*pNode = *pSlot = 0;
+		return 0;
+	}
+
+	while (lo < hi)
+	{
+		int mid = (lo + hi) / 2;
+		node = pList->dir[mid];
+		if (pList->compare(pArgu, node->dataPtr[node->count - 1]) > 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	if (lo == pList->ndir)
+	{
+		// 모든 데이터보다 큼: 마지막 노드의 끝
+		*pNode = pList->ndir - 1;
+		*pSlot = pList->dir[*pNode]->count;
+		return 0;
+	}
+
+	node = pList->dir[lo];
+	*pNode = lo;
+
+	// 노드의 마지막 데이터 >= target 이므로 slot은 count - 1 이하
+	int l = 0, h = node->count - 1;
+	while (l < h)
+	{
+		int mid = (l + h) / 2;
+		if (pList->compare(pArgu, node->dataPtr[mid]) > 0)
+			l = mid + 1;
+		else
+			h = mid;
+	}
+	*pSlot = l;
+	return (pList->compare(pArgu, node->dataPtr[l]) == 0) ? 1 : 0;
+}
+
+// internal insert function
+// inserts data at slot of node d, splitting the node in half if it is full
+// for addNode function
+// return	1 if successful
+// 			0 if memory overflow
+static int _insert(LIST *pList, int d, int slot, void *dataInPtr)
+{
+	NODE *node;
+
+	if (pList->ndir == 0)
+	{
+		node = _newNode(pList);
+		if (!node)
+			return 0;
+		if (!_dirInsert(pList, 0, node))
+		{
+			_freeNode(pList, node);
+			return 0;
+		}
+		d = slot = 0;
+	}
+
+	node = pList->dir[d];
+	if (node->count == ULIST_SLOTS)
+	{
+		NODE *right = _newNode(pList);
+		int half = ULIST_SLOTS / 2;
+		if (!right)
+			return 0;
+		if (!_dirInsert(pList, d + 1, right))
+		{
+			_freeNode(pList, right);
+			return 0;
+		}
+		memcpy(right->dataPtr, &node->dataPtr[half], (ULIST_SLOTS - half) * sizeof(void *));
+		right->count = ULIST_SLOTS - half;
+		node->count = half;
+		if (slot > half)
+		{
+			node = right;
+			slot -= half;
+		}
+	}
+
+	memmove(&node->dataPtr[slot + 1], &node->dataPtr[slot], (node->count - slot) * sizeof(void *));
+	node->dataPtr[slot] = dataInPtr;
+	node->count++;
+	pList->count++;
+	return 1;
+}
+
+// internal delete function
+// deletes data at slot of node d and saves the (deleted) data to dataOutPtr
+// an empty node is freed; a node merges with its right neighbor when both fit in half a node
+// for removeNode function
+static void _delete(LIST *pList, int d, int slot, void **dataOutPtr)
+{
+	NODE *node = pList->dir[d];
+
+	*dataOutPtr = node->dataPtr[slot];
+	memmove(&node->dataPtr[slot], &node->dataPtr[slot + 1], (node->count - slot - 1) * sizeof(void *));
+	node->count--;
+	pList->count--;
+
+	if (node->count == 0)
+	{
+		_dirRemove(pList, d);
+		return;
+	}
+	if (d + 1 < pList->ndir)
+	{
+		NODE *right = pList->dir[d + 1];
+		if (node->count + right->count <= ULIST_SLOTS / 2)
+		{
+			memcpy(&node->dataPtr[node->count], right->dataPtr, right->count * sizeof(void *));
+			node->count += right->count;
+			_dirRemove(pList, d + 1);
+		}
+	}
+}
+
+// internal function
+// drops the snapshot made by freezeList (called before data is added or removed)
+static void _thaw(LIST *pList)
+{
+	eytz_Destroy(pList->frozen);
+	pList->frozen = NULL;
+}
+
+LIST *createList(int (*compare)(const void *, const void *))
+{
+	return createListEx(compare, 0);
+}
+
+LIST *createListEx(int (*compare)(const void *, const void *), int flags)
+{
+	LIST *list = (LIST *)malloc(sizeof(LIST));
+	if (!list)
+		return NULL;
+	list->count = 0;
+	list->dir = NULL;
+	list->ndir = list->dirCapacity = 0;
+	list->compare = compare;
+	list->pool = NULL;
+	list->frozen = NULL;
+	if (flags & LIST_POOL)
+	{
+		list->pool = pool_Create(sizeof(NODE), 0);
+		if (!list->pool)
+		{
+			free(list);
+			return NULL;
+		}
+	}
+	return list;
+}
+
+void destroyList(LIST *pList, void (*callback)(void *))
+{
+	if (!pList)
+		return;
+	for (int d = 0; d < pList->ndir; d++)
+	{
+		NODE *node = pList->dir[d];
+		if (callback)
+			for (int i = 0; i < node->count; i++)
+				callback(node->dataPtr[i]);
+		// pool에서 할당한 노드는 pool_Destroy에서 slab 단위로 해제
+		if (!pList->pool)
+			free(node);
+	}
+	_thaw(pList);
+	pool_Destroy(pList->pool);
+	free(pList->dir);
+	free(pList);
+}
+
+int addNode(LIST *pList, void *dataInPtr, void (*callback)(const void *))
+{
+	if (!pList || !dataInPtr)
+		return 0;
+	int d, slot;
+	if (_search(pList, &d, &slot, dataInPtr))
+	{
+		// duplicate
+		if (callback)
+			callback(pList->dir[d]->dataPtr[slot]);
+		return 2;
+	}
+	// insert
+	_thaw(pList);
+	return _insert(pList, d, slot, dataInPtr);
+}
+
+int removeNode(LIST *pList, void *keyPtr, void **dataOutPtr)
+{
+	if (!pList)
+		return 0;
+	int d, slot;
+	if (!_search(pList, &d, &slot, keyPtr))
+		return 0;
+	_thaw(pList);
+	_delete(pList, d, slot, dataOutPtr);
+	return 1;
+}
+
+int searchNode(LIST *pList, void *pArgu, void **dataOutPtr)
+{
+	if (!pList)
+		return 0;
+	if (pList->frozen)
+	{
+		void *found = eytz_Search(pList->frozen, pArgu);
+		if (found && dataOutPtr)
+			*dataOutPtr = found;
+		return found ? 1 : 0;
+	}
+	int d, slot;
+	if (_search(pList, &d, &slot, pArgu))
+	{
+		if (dataOutPtr)
+			*dataOutPtr = pList->dir[d]->dataPtr[slot];
+		return 1;
+	}
+	return 0;
+}
+
+int freezeList(LIST *pList, unsigned long long (*key)(const void *))
+{
+	if (!pList)
+		return 0;
+	_thaw(pList);
+	void **sorted = (void **)malloc((pList->count + 1) * sizeof(void *));
+	if (!sorted)
+		return 0;
+	int n = 0;
+	for (int d = 0; d < pList->ndir; d++)
+		for (int i = 0; i < pList->dir[d]->count; i++)
+			sorted[n++] = pList->dir[d]->dataPtr[i];
+	pList->frozen = eytz_Create(sorted, n, pList->compare, key);
+	free(sorted);
+	return pList->frozen ? 1 : 0;
+}
+
+int countList(LIST *pList)
+{
+	return pList ? pList->count : 0;
+}
+
+int emptyList(LIST *pList)
+{
+	return (pList && pList->count == 0) ? 1 : 0;
+}
+
+void traverseList(LIST *pList, void (*callback)(const void *))
+{
+	for (int d = 0; d < pList->ndir; d++)
+	{
+		NODE *node = pList->dir[d];
+		for (int i = 0; i < node->count; i++)
+			callback(node->dataPtr[i]);
+	}
+}
+
+void traverseListR(LIST *pList, void (*callback)(const void *))
+{
+	for (int d = pList->ndir - 1; d >= 0; d--)
+	{
+		NODE *node = pList->dir[d];
+		for (int i = node->count - 1; i >= 0; i--)
+			callback(node->dataPtr[i]);
+	}
+}
@@ -0,0 +1,85 @@
+#include "pool.h"
+#include "eytz.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// LIST type definition (unrolled list)
+// adt_dlist.h와 같은 함수를 제공하는 정렬된 unrolled linked list
+// 노드 하나에 데이터 포인터를 ULIST_SLOTS개까지 순서대로 저장하고,
+// 노드 포인터 배열(dir)을 이진 탐색하여 노드를 찾음
+// traverseList/traverseListR은 노드 안의 배열을 연속으로 읽음
+#define ULIST_SLOTS 30 // 노드당 데이터 수 (노드 크기 248 bytes, pool에서는 16 bytes 단위로 올려 256 bytes)
+
+typedef struct unode
+{
+	int count; // 노드에 저장된 데이터 수
+	void *dataPtr[ULIST_SLOTS]; // compare 순으로 정렬된 데이터
+} NODE;
+
+typedef struct
+{
+	int count;
+	NODE **dir; // 노드 포인터 배열 (순서대로)
+	int ndir; // 노드 수
+	int dirCapacity;
+	int (*compare)(const void *, const void *); // used in _search function
+	POOL *pool; // node allocator (LIST_POOL), NULL if nodes are malloc'd
+	EYTZ *frozen; // freezeList로 만든 읽기 전용 snapshot (데이터가 추가/삭제되면 NULL)
+} LIST;
+
+// createListEx flags
+#define LIST_POOL 0x1 // 노드를 slab pool에서 할당: 연속된 메모리, destroyList는 slab 단위로 해제
+
+////////////////////////////////////////////////////////////////////////////////
+// function declarations
+
+// Allocates dynamic memory for a list head node and returns its address to caller
+// return	head node pointer
+// 			NULL if overflow
+LIST *createList(int (*compare)(const void *, const void *));
+
+// Same as createList, with options
+// flags	0 or LIST_POOL
+LIST *createListEx(int (*compare)(const void *, const void *), int flags);
+
+//  이름 리스트에 할당된 메모리를 해제 (head node, data node)
+// callback이 NULL이면 데이터는 해제하지 않음 (호출한 쪽에서 한꺼번에 해제하는 경우)
+void destroyList(LIST *pList, void (*callback)(void *));
+
+// Inserts data into list
+// callback은 이미 리스트에 존재하는 데이터를 발견했을 때 호출하는 함수
+//	return	0 if overflow
+//			1 if successful
+//			2 if duplicated key
+int addNode(LIST *pList, void *dataInPtr, void (*callback)(const void *));
+
+// Removes data from list
+//	return	0 not found
+//			1 deleted
+int removeNode(LIST *pList, void *keyPtr, void **dataOutPtr);
+
+// interface to search function
+//	pArgu	key being sought
+//	dataOutPtr	contains found data
+//	return	1 successful
+//			0 not found
+int searchNode(LIST *pList, void *pArgu, void **dataOutPtr);
+
+// Makes a read-only snapshot of the list in a contiguous array (eytz.h) for searchNode
+// 리스트는 그대로 남고, 이후 addNode로 데이터가 추가되거나 removeNode로 삭제되면 snapshot은 버려짐
+//	key	optional order-preserving key of data (see eytz_Create), NULL: compare only
+//	return	1 successful
+//			0 overflow (searchNode는 리스트를 그대로 사용)
+int freezeList(LIST *pList, unsigned long long (*key)(const void *));
+
+// returns number of nodes in list
+int countList(LIST *pList);
+
+// returns	1 empty
+//			0 list has data
+int emptyList(LIST *pList);
+
+// traverses data from list (forward)
+void traverseList(LIST *pList, void (*callback)(const void *));
+
+// traverses data from list (backward)
+void traverseListR(LIST *pList, void (*callback)(const void *));
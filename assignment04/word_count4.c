@@ -1,9 +1,19 @@
 #include <stdio.h>
 #include <stdlib.h> // malloc
-#include <string.h> // strdup, strcmp
+#include <string.h> // strlen, memcpy, strcmp
 #include <ctype.h>	// toupper
 
+#include "tokenizer.h"
+#include "arena.h"
+#include "batch.h"
+#include "eytz.h"
+
+// UNROLLED로 컴파일하면 같은 LIST 함수를 unrolled list로 사용 (word_count4u)
+#ifdef UNROLLED
+#include "adt_ulist.h"
+#else
 #include "adt_dlist.h"
+#endif
 
 #define QUIT 1
 #define FORWARD_PRINT 2
@@ -20,42 +30,40 @@ typedef struct
 	int freq;	// 빈도
 } tWord;
 
+// 단어 구조체와 문자열 저장 공간
+// 리스트를 해제한 후 arena_Destroy로 한꺼번에 해제
+static ARENA *wordArena;
+
 ////////////////////////////////////////////////////////////////////////////////
 // 단어 구조체를 위한 메모리를 할당하고 word, freq 초기화
+// 단어 구조체와 문자열은 wordArena에서 한 번에 할당
 // return	할당된 단어 구조체에 대한 pointer
 //			NULL if overflow
 tWord *createWord(char *word)
 {
-	tWord *w = (tWord *)malloc(sizeof(tWord));
+	size_t len = strlen(word);
+	tWord *w = (tWord *)arena_Alloc(wordArena, sizeof(tWord) + len + 1);
 	if (!w)
 		return NULL;
-	w->word = strdup(word);
-	if (!w->word)
-	{
-		free(w);
-		return NULL;
-	}
+	w->word = (char *)(w + 1);
+	memcpy(w->word, word, len + 1);
 	w->freq = 1;
 	return w;
 }
 
 //  단어 구조체에 할당된 메모리를 해제
-// for destroyList function
+// 가장 최근에 할당한 단어만 즉시 반환되고, 나머지는 arena_Destroy에서 해제됨
 void destroyWord(void *pNode)
 {
-	tWord *w = (tWord *)pNode;
-	free(w->word);
-	free(w);
+	arena_Free(wordArena, pNode);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-// gets user's input
-int get_action()
+// converts a menu character to an action
+// for get_action and run_batch functions
+int to_action(int ch)
 {
-	char ch;
-	scanf("%c", &ch);
-	ch = toupper(ch);
-	switch (ch)
+	switch (toupper(ch))
 	{
 	case 'Q':
 		return QUIT;
@@ -73,6 +81,14 @@ int get_action()
 	return 0; // undefined action
 }
 
+// gets user's input
+int get_action()
+{
+	char ch;
+	scanf("%c", &ch);
+	return to_action(ch);
+}
+
 // compares two words in word structures
 // for createList function
 // 정렬 기준 : 단어
@@ -84,6 +100,13 @@ int compare_by_word(const void *n1, const void *n2)
 	return strcmp(p1->word, p2->word);
 }
 
+// 단어의 앞 8 bytes (eytz_StrKey): key가 다르면 문자열을 읽지 않고 비교할 수 있음
+// for freezeList function
+unsigned long long word_key(const void *dataPtr)
+{
+	return eytz_StrKey(((tWord *)dataPtr)->word);
+}
+
 // prints contents of word structure
 // for traverseList and traverseListR functions
 void print_word(const void *dataPtr)
@@ -100,7 +123,75 @@ void increase_freq(const void *dataPtr)
 void input_word(char *word)
 {
 	fprintf(stderr, "Input a word to find: ");
-	fscanf(stdin, "%s", word);
+	fscanf(stdin, "%99s", word);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 명령 파일의 명령을 차례로 실행 (Q를 만나면 끝), 출력 형식은 메뉴와 같음
+// 연속된 S)earch는 단어 순으로 정렬하여 찾고 (이웃한 단어를 연달아 찾음), 결과는 원래 순서대로 출력
+// return	실행한 명령 수
+int run_batch(LIST *list, BATCH *batch)
+{
+	tWord key; // 검색에는 단어만 사용
+	void *ptr;
+	int i = 0;
+
+	while (i < batch->n)
+	{
+		BATCH_CMD *cmd = &batch->cmds[i];
+
+		switch (to_action(cmd->action))
+		{
+		case QUIT:
+			return i;
+
+		case FORWARD_PRINT:
+			traverseList(list, print_word);
+			break;
+
+		case BACKWARD_PRINT:
+			traverseListR(list, print_word);
+			break;
+
+		case SEARCH:
+		{
+			int run = batch_SortRun(batch, i);
+
+			for (int k = 0; k < run; k++)
+			{
+				key.word = batch->order[k]->arg;
+				batch->order[k]->result = searchNode(list, &key, &ptr) ? ptr : NULL;
+			}
+			for (int k = i; k < i + run; k++)
+			{
+				if (batch->cmds[k].result)
+					print_word(batch->cmds[k].result);
+				else
+					fprintf(stdout, "%s not found\n", batch->cmds[k].arg);
+			}
+			i += run;
+			continue;
+		}
+
+		case DELETE:
+			key.word = cmd->arg;
+
+			if (removeNode(list, &key, &ptr))
+			{
+				fprintf(stdout, "%s\t%d deleted\n", ((tWord *)ptr)->word, ((tWord *)ptr)->freq);
+				destroyWord(ptr);
+			}
+			else
+				fprintf(stdout, "%s not found\n", cmd->arg);
+			break;
+
+		case COUNT:
+			fprintf(stdout, "%d\n", countList(list));
+			break;
+		}
+		i++;
+	}
+	return i;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -111,32 +202,50 @@ int main(int argc, char **argv)
 	char word[100];
 	tWord *pWord;
 	int ret;
-	FILE *fp;
+	TOKENIZER *tok;
+	char *token;
+	char *filename = NULL;
+	char *queries = NULL;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-q") == 0 && i + 1 < argc)
+			queries = argv[++i];
+		else if (argv[i][0] == '-' || filename)
+		{
+			filename = NULL;
+			break;
+		}
+		else
+			filename = argv[i];
+	}
 
-	if (argc != 2)
+	if (!filename)
 	{
-		fprintf(stderr, "usage: %s FILE\n", argv[0]);
+		fprintf(stderr, "usage: %s [-q QUERIES] FILE\n", argv[0]);
+		fprintf(stderr, "\t-q\trun the menu commands in QUERIES (S/D/C/P/B/Q) instead of reading stdin\n");
 		return 1;
 	}
 
-	fp = fopen(argv[1], "rt");
-	if (!fp)
+	tok = tok_Open(filename);
+	if (!tok)
 	{
-		fprintf(stderr, "Error: cannot open file [%s]\n", argv[1]);
+		fprintf(stderr, "Error: cannot open file [%s]\n", filename);
 		return 2;
 	}
 
 	// creates an empty list
-	list = createList(compare_by_word);
-	if (!list)
+	wordArena = arena_Create(0);
+	list = createListEx(compare_by_word, LIST_POOL);
+	if (!list || !wordArena)
 	{
 		printf("Cannot create list\n");
 		return 100;
 	}
 
-	while (fscanf(fp, "%s", word) != EOF)
+	while ((token = tok_NextWord(tok)) != NULL)
 	{
-		pWord = createWord(word);
+		pWord = createWord(token);
 
 		// 이미 저장된 단어는 빈도 증가
 		ret = addNode(list, pWord, increase_freq);
@@ -147,7 +256,33 @@ int main(int argc, char **argv)
 		}
 	}
 
-	fclose(fp);
+	tok_Close(tok);
+
+	// 메뉴에서는 주로 찾기만 하므로 읽기 전용 snapshot을 만들어 S)earch에 사용 (D)elete 후에는 리스트를 사용)
+	freezeList(list, word_key);
+
+	if (queries)
+	{
+		BATCH *batch = batch_Load(queries, "SD");
+		if (!batch)
+		{
+			fprintf(stderr, "Error: cannot open file [%s]\n", queries);
+			return 2;
+		}
+
+		// 결과는 한꺼번에 출력
+		setvbuf(stdout, NULL, _IOFBF, 1 << 16);
+		double start = batch_Clock();
+		int n = run_batch(list, batch);
+		fflush(stdout);
+		double sec = batch_Clock() - start;
+		fprintf(stderr, "%d queries in %.3f s (%.0f queries/sec)\n", n, sec, n / (sec > 0 ? sec : 1e-9));
+
+		batch_Destroy(batch);
+		destroyList(list, NULL);
+		arena_Destroy(wordArena);
+		return 0;
+	}
 
 	fprintf(stderr, "Select Q)uit, P)rint, B)ackward print, S)earch, D)elete, C)ount: ");
 
@@ -159,7 +294,9 @@ int main(int argc, char **argv)
 		switch (action)
 		{
 		case QUIT:
-			destroyList(list, destroyWord);
+			// 단어는 arena와 함께 한꺼번에 해제
+			destroyList(list, NULL);
+			arena_Destroy(wordArena);
 			return 0;
 
 		case FORWARD_PRINT:
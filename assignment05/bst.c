@@ -4,21 +4,33 @@
 #include "bst.h"
 
 /* Internal helper prototypes */
-static int _insert(NODE *root, NODE *newPtr,
-                   int (*compare)(const void *, const void *),
-                   void (*callback)(void *));
-static NODE *_makeNode(void *dataInPtr);
-static void _destroy(NODE *root, void (*destroy)(void *));
-static NODE *_delete(NODE *root, void *keyPtr, void **dataOutPtr,
-                     int (*compare)(const void *, const void *));
+static NODE *_makeNode(TREE *pTree, void *dataInPtr);
+static void _freeNode(TREE *pTree, NODE *node);
+static void _destroy(TREE *pTree, void (*destroy)(void *));
 static NODE *_search(NODE *root, void *keyPtr,
                      int (*compare)(const void *, const void *));
-static void _traverse(NODE *root, void (*callback)(const void *));
-static void _traverseR(NODE *root, void (*callback)(const void *));
-static void _inorder_print(NODE *root, int level, void (*callback)(const void *));
+static void _unlink(TREE *pTree, NODE *node);
+static void _inorder_print(NODE *root, void (*callback)(const void *));
+static NODE *_first(NODE *root);
+static NODE *_lowerBound(NODE *root, void *keyPtr,
+                         int (*compare)(const void *, const void *));
+static NODE *_last(NODE *root);
+static NODE *_next(NODE *node);
+static NODE *_prev(NODE *node);
+static void _rebalance(TREE *pTree, NODE *node);
+static int _size(NODE *root);
+static int _rank(TREE *pTree, void *keyPtr, int inclusive);
+static void _vineToTree(TREE *pTree, NODE *pseudo, int size);
+static void _thaw(TREE *pTree);
 
 /* Create a new empty BST */
 TREE *BST_Create(int (*compare)(const void *, const void *))
+{
+    return BST_CreateEx(compare, 0);
+}
+
+/* Create a new empty BST with options (BST_AVL) */
+TREE *BST_CreateEx(int (*compare)(const void *, const void *), int flags)
 {
     TREE *pTree = (TREE *)malloc(sizeof(TREE));
     if (pTree)
@@ -26,6 +38,18 @@ TREE *BST_Create(int (*compare)(const void *, const void *))
         pTree->root = NULL;
         pTree->compare = compare;
         pTree->count = 0;
+        pTree->flags = flags;
+        pTree->pool = NULL;
+        pTree->frozen = NULL;
+        if (flags & BST_POOL)
+        {
+            pTree->pool = pool_Create(sizeof(NODE), 0);
+            if (!pTree->pool)
+            {
+                free(pTree);
+                return NULL;
+            }
+        }
     }
     return pTree;
 }
@@ -35,7 +59,9 @@ void BST_Destroy(TREE *pTree, void (*destroy)(void *))
 {
     if (pTree)
     {
-        _destroy(pTree->root, destroy);
+        _thaw(pTree);
+        _destroy(pTree, destroy);
+        pool_Destroy(pTree->pool);
         free(pTree);
     }
 }
@@ -43,247 +69,521 @@ void BST_Destroy(TREE *pTree, void (*destroy)(void *))
 /* Insert data into the BST. callback handles duplicates */
 int BST_Insert(TREE *pTree, void *dataInPtr, void (*callback)(void *))
 {
-    NODE *newPtr = _makeNode(dataInPtr);
+    NODE *parent = NULL;
+    NODE *cur = pTree->root;
+    int comp = 0;
+
+    /* 삽입 위치(또는 중복 노드)를 반복문으로 찾음 */
+    while (cur)
+    {
+        comp = pTree->compare(dataInPtr, cur->dataPtr);
+        if (comp == 0)
+        {
+            /* 중복: 호출한 쪽에서 dataInPtr를 해제 */
+            if (callback)
+                callback(cur->dataPtr);
+            return 2;
+        }
+        parent = cur;
+        cur = comp < 0 ? cur->left : cur->right;
+    }
+
+    NODE *newPtr = _makeNode(pTree, dataInPtr);
     if (!newPtr)
         return 0; /* malloc failed */
 
-    if (pTree->root == NULL)
-    {
+    _thaw(pTree);
+    newPtr->parent = parent;
+    if (!parent)
         pTree->root = newPtr;
-        pTree->count++;
-        return 1;
+    else if (comp < 0)
+        parent->left = newPtr;
+    else
+        parent->right = newPtr;
+    pTree->count++;
+
+    /* 새 노드의 조상들의 서브트리 크기를 늘림 (회전은 크기를 다시 계산) */
+    for (NODE *p = parent; p; p = p->parent)
+        p->size++;
+
+    if (pTree->flags & BST_AVL)
+        _rebalance(pTree, parent);
+    return 1;
+}
+
+/* Build a balanced tree from sorted data */
+int BST_BuildSorted(TREE *pTree, void **sorted, int n)
+{
+    NODE pseudo; /* vine의 head 앞에 두는 가짜 root */
+    NODE *tail = &pseudo;
+
+    if (pTree->root || n < 0)
+        return 0;
+    for (int i = 1; i < n; i++)
+        if (pTree->compare(sorted[i - 1], sorted[i]) >= 0)
+            return 0;
+
+    /* 오른쪽 자식으로만 이어진 vine을 만든 뒤 접음 */
+    _thaw(pTree);
+    pseudo.right = NULL;
+    for (int i = 0; i < n; i++)
+    {
+        NODE *node = _makeNode(pTree, sorted[i]);
+        if (!node)
+        {
+            for (node = pseudo.right; node; )
+            {
+                NODE *next = node->right;
+                _freeNode(pTree, node);
+                node = next;
+            }
+            return 0;
+        }
+        node->parent = tail;
+        tail->right = node;
+        tail = node;
     }
 
-    int status = _insert(pTree->root, newPtr, pTree->compare, callback);
-    if (status == 1)
+    _vineToTree(pTree, &pseudo, n);
+    pTree->count = n;
+    return 1;
+}
+
+/* Rebuild the tree in place (Day-Stout-Warren) */
+void BST_Rebalance(TREE *pTree)
+{
+    NODE pseudo;
+    NODE *tail = &pseudo;
+    NODE *rest = pTree->root;
+
+    /* tree to vine: 왼쪽 자식이 있으면 오른쪽으로 회전, 없으면 vine에 붙이고 진행 */
+    while (rest)
     {
-        pTree->count++;
-        return 1;
+        if (rest->left)
+        {
+            NODE *pivot = rest->left;
+            rest->left = pivot->right;
+            pivot->right = rest;
+            rest = pivot;
+        }
+        else
+        {
+            rest->parent = tail;
+            tail->right = rest;
+            tail = rest;
+            rest = rest->right;
+        }
     }
-    /* status == -1 (duplicate) or 0 (error) */
-    return status == -1 ? 1 : 0;
+    tail->right = NULL;
+
+    _vineToTree(pTree, &pseudo, pTree->count);
 }
 
 /* Delete a node matching keyPtr */
 void *BST_Delete(TREE *pTree, void *keyPtr)
 {
-    void *dataOut = NULL;
-    pTree->root = _delete(pTree->root, keyPtr, &dataOut, pTree->compare);
-    if (dataOut)
-        +pTree->count--;
+    NODE *node = _search(pTree->root, keyPtr, pTree->compare);
+    if (!node)
+        return NULL;
+
+    void *dataOut = node->dataPtr;
+    _thaw(pTree);
+    _unlink(pTree, node);
+    _freeNode(pTree, node);
+    pTree->count--;
     return dataOut;
 }
 
 /* Search for a node matching keyPtr */
 void *BST_Search(TREE *pTree, void *keyPtr)
 {
+    if (pTree->frozen)
+        return eytz_Search(pTree->frozen, keyPtr);
+
     NODE *found = _search(pTree->root, keyPtr, pTree->compare);
     return found ? found->dataPtr : NULL;
 }
 /* In-order traversal */
 void BST_Traverse(TREE *pTree, void (*callback)(const void *))
 {
-    _traverse(pTree->root, callback);
+    for (NODE *node = _first(pTree->root); node; node = _next(node))
+        callback(node->dataPtr);
 }
 
 /* Reverse in-order traversal */
 void BST_TraverseR(TREE *pTree, void (*callback)(const void *))
 {
-    _traverseR(pTree->root, callback);
+    for (NODE *node = _last(pTree->root); node; node = _prev(node))
+        callback(node->dataPtr);
 }
 
-/* Print tree sideways */
-void printTree(TREE *pTree, void (*callback)(const void *))
+/* Order statistics: k-th smallest */
+void *BST_Select(TREE *pTree, int k)
 {
-    _inorder_print(pTree->root, 0, callback);
-}
+    NODE *node = pTree->root;
 
-/*----- Internal helper definitions -----*/
-
-// static int _insert(NODE *root, NODE *newPtr,
-//                    int (*compare)(const void *, const void *),
-//                    void (*callback)(void *))
-// {
-//     int comp = compare(newPtr->dataPtr, root->dataPtr);
-//     if (comp == 0)
-//     {
-//         if (callback)
-//             callback(root->dataPtr);
-//         free(newPtr);
-//         return -1;
-//     }
-//     else if (comp < 0)
-//     {
-//         if (root->left)
-//             return _insert(root->left, newPtr, compare, callback);
-//         root->left = newPtr;
-//         return 1;
-//     }
-//     else
-//     {
-//         if (root->right)
-//             return _insert(root->right, newPtr, compare, callback);
-//         root->right = newPtr;
-//         return 1;
-//     }
-// }
-
-static int _insert(NODE *root, NODE *newPtr,
-                   int (*compare)(const void *, const void *),
-                   void (*callback)(void *))
-{
-    int comp = compare(newPtr->dataPtr, root->dataPtr);
-
-    /* 중복된 단어: 빈도만 증가시키고, 새로 할당된 payload와 노드는 전부 해제 */
-    if (comp == 0)
+    if (k < 1 || k > pTree->count)
+        return NULL;
+    while (node)
     {
-        if (callback)
-            callback(root->dataPtr);
+        int left = _size(node->left);
+        if (k == left + 1)
+            return node->dataPtr;
+        if (k <= left)
+            node = node->left;
+        else
+        {
+            k -= left + 1;
+            node = node->right;
+        }
+    }
+    return NULL;
+}
 
-        /* newPtr->dataPtr가 가리키는 구조체의 첫 번째 멤버(char *word) 꺼내기 */
-        char *dupWord = *(char **)(newPtr->dataPtr);
-        free(dupWord);         /* strdup으로 할당된 문자열 해제 */
-        free(newPtr->dataPtr); /* tWord 구조체 자체 해제 */
-        free(newPtr);          /* NODE 구조체 해제 */
+/* Number of keys smaller than keyPtr */
+int BST_Rank(TREE *pTree, void *keyPtr)
+{
+    return _rank(pTree, keyPtr, 0);
+}
 
-        return -1;
-    }
+/* Number of keys in [loPtr, hiPtr] */
+int BST_CountRange(TREE *pTree, void *loPtr, void *hiPtr)
+{
+    if (pTree->compare(loPtr, hiPtr) > 0)
+        return 0;
+    return _rank(pTree, hiPtr, 1) - _rank(pTree, loPtr, 0);
+}
+
+/* In-order traversal of [loPtr, hiPtr] */
+int BST_TraverseRange(TREE *pTree, void *loPtr, void *hiPtr, void (*callback)(const void *))
+{
+    int count = 0;
 
-    if (comp < 0)
+    for (NODE *node = _lowerBound(pTree->root, loPtr, pTree->compare);
+         node && pTree->compare(hiPtr, node->dataPtr) >= 0; node = _next(node))
     {
-        if (root->left)
-            return _insert(root->left, newPtr, compare, callback);
-        root->left = newPtr;
-        return 1;
+        callback(node->dataPtr);
+        count++;
     }
-    else
+    return count;
+}
+
+/* In-order traversal of the data matching keyPtr */
+int BST_TraversePrefix(TREE *pTree, void *keyPtr,
+                       int (*match)(const void *, const void *), void (*callback)(const void *))
+{
+    int count = 0;
+
+    for (NODE *node = _lowerBound(pTree->root, keyPtr, match);
+         node && match(keyPtr, node->dataPtr) == 0; node = _next(node))
     {
-        if (root->right)
-            return _insert(root->right, newPtr, compare, callback);
-        root->right = newPtr;
-        return 1;
+        callback(node->dataPtr);
+        count++;
     }
+    return count;
+}
+
+/* Read-only snapshot for BST_Search */
+int BST_Freeze(TREE *pTree, unsigned long long (*key)(const void *))
+{
+    void **sorted = (void **)malloc((pTree->count + 1) * sizeof(void *));
+    int n = 0;
+
+    _thaw(pTree);
+    if (!sorted)
+        return 0;
+    for (NODE *node = _first(pTree->root); node; node = _next(node))
+        sorted[n++] = node->dataPtr;
+    pTree->frozen = eytz_Create(sorted, n, pTree->compare, key);
+    free(sorted);
+    return pTree->frozen != NULL;
+}
+
+/* Print tree sideways */
+void printTree(TREE *pTree, void (*callback)(const void *))
+{
+    _inorder_print(pTree->root, callback);
 }
 
-static NODE *_makeNode(void *dataInPtr)
+/* In-order iterator */
+void BST_IterBegin(TREE *pTree, BST_ITER *pIter)
 {
-    NODE *newNode = (NODE *)malloc(sizeof(NODE));
+    pIter->node = _first(pTree->root);
+    pIter->reverse = 0;
+}
+
+void BST_IterBeginR(TREE *pTree, BST_ITER *pIter)
+{
+    pIter->node = _last(pTree->root);
+    pIter->reverse = 1;
+}
+
+void *BST_IterNext(BST_ITER *pIter)
+{
+    NODE *node = pIter->node;
+    if (!node)
+        return NULL;
+    pIter->node = pIter->reverse ? _prev(node) : _next(node);
+    return node->dataPtr;
+}
+
+/*----- Internal helper definitions -----*/
+/* 모든 내부 함수는 반복문과 parent 링크만 사용 (트리 높이에 비례하는 스택을 쓰지 않음) */
+
+static NODE *_makeNode(TREE *pTree, void *dataInPtr)
+{
+    NODE *newNode;
+    if (pTree->pool)
+        newNode = (NODE *)pool_Alloc(pTree->pool);
+    else
+        newNode = (NODE *)malloc(sizeof(NODE));
     if (!newNode)
         return NULL;
     newNode->dataPtr = dataInPtr;
-    newNode->left = newNode->right = NULL;
+    newNode->left = newNode->right = newNode->parent = NULL;
+    newNode->height = 1;
+    newNode->size = 1;
     return newNode;
 }
 
-static void _destroy(NODE *root, void (*destroy)(void *))
+static void _freeNode(TREE *pTree, NODE *node)
 {
-    if (root)
+    if (pTree->pool)
+        pool_Free(pTree->pool, node);
+    else
+        free(node);
+}
+
+/* post-order로 해제: 잎 노드를 해제하고 부모로 올라감
+   pool을 쓰는 경우 노드는 BST_Destroy에서 slab 단위로 해제되므로 데이터만 해제 */
+static void _destroy(TREE *pTree, void (*destroy)(void *))
+{
+    NODE *node = pTree->root;
+
+    if (pTree->pool)
     {
-        _destroy(root->left, destroy);
-        _destroy(root->right, destroy);
         if (destroy)
-            destroy(root->dataPtr);
-        free(root);
+            for (node = _first(pTree->root); node; node = _next(node))
+                destroy(node->dataPtr);
+        return;
+    }
+
+    while (node)
+    {
+        if (node->left)
+            node = node->left;
+        else if (node->right)
+            node = node->right;
+        else
+        {
+            NODE *parent = node->parent;
+            if (parent)
+            {
+                if (parent->left == node)
+                    parent->left = NULL;
+                else
+                    parent->right = NULL;
+            }
+            if (destroy)
+                destroy(node->dataPtr);
+            free(node);
+            node = parent;
+        }
     }
 }
 
-static NODE *_delete(NODE *root, void *keyPtr, void **dataOutPtr,
+static NODE *_search(NODE *root, void *keyPtr,
                      int (*compare)(const void *, const void *))
 {
-    if (!root)
-        return NULL;
-
-    int comp = compare(keyPtr, root->dataPtr);
-    if (comp < 0)
+    while (root)
     {
-        root->left = _delete(root->left, keyPtr, dataOutPtr, compare);
-        return root;
-    }
-    if (comp > 0)
-    {
-        root->right = _delete(root->right, keyPtr, dataOutPtr, compare);
-        return root;
+        int comp = compare(keyPtr, root->dataPtr);
+        if (comp == 0)
+            return root;
+        root = comp < 0 ? root->left : root->right;
     }
+    return NULL;
+}
 
-    /* 삭제 대상 노드(root) 발견 */
-    /* 자식이 두 개인 경우: in-order successor로 대체 */
-    if (root->left && root->right)
+/* compare(keyPtr, data) <= 0인 첫 노드 (in-order에서 keyPtr 이상인 첫 노드)
+   왼쪽으로 내려갈 때의 노드가 후보 */
+static NODE *_lowerBound(NODE *root, void *keyPtr,
+                         int (*compare)(const void *, const void *))
+{
+    NODE *bound = NULL;
+
+    while (root)
     {
-        /* 1) 삭제할 원본 데이터 보관 */
-        if (dataOutPtr)
-            *dataOutPtr = root->dataPtr;
-        /* 2) 오른쪽 서브트리에서 가장 작은 노드 찾기 */
-        NODE *succParent = root;
-        NODE *succ = root->right;
-        while (succ->left)
+        if (compare(keyPtr, root->dataPtr) <= 0)
         {
-            succParent = succ;
-            succ = succ->left;
+            bound = root;
+            root = root->left;
         }
+        else
+            root = root->right;
+    }
+    return bound;
+}
 
-        /* 3) successor 데이터만 복사 */
-        root->dataPtr = succ->dataPtr;
+static NODE *_first(NODE *root)
+{
+    if (root)
+        while (root->left)
+            root = root->left;
+    return root;
+}
 
-        /* 4) successor 노드 삭제 (dataOutPtr 덮어쓰지 않도록 NULL 전달) */
-        if (succParent->left == succ)
-            succParent->left = _delete(succ, succ->dataPtr, NULL, compare);
-        else
-            succParent->right = _delete(succ, succ->dataPtr, NULL, compare);
+static NODE *_last(NODE *root)
+{
+    if (root)
+        while (root->right)
+            root = root->right;
+    return root;
+}
 
-        return root;
-    }
+/* in-order successor */
+static NODE *_next(NODE *node)
+{
+    if (node->right)
+        return _first(node->right);
+    while (node->parent && node->parent->right == node)
+        node = node->parent;
+    return node->parent;
+}
 
-    /* 자식이 하나 이하인 경우: 바로 제거 */
-    //*dataOutPtr = root->dataPtr;
-    if (dataOutPtr)
-        *dataOutPtr = root->dataPtr;
-    NODE *next = root->left ? root->left : root->right;
-    free(root);
-    return next;
+/* in-order predecessor */
+static NODE *_prev(NODE *node)
+{
+    if (node->left)
+        return _last(node->left);
+    while (node->parent && node->parent->left == node)
+        node = node->parent;
+    return node->parent;
 }
 
-static NODE *_search(NODE *root, void *keyPtr,
-                     int (*compare)(const void *, const void *))
+static int _size(NODE *root)
 {
-    if (!root)
-        return NULL;
-    int comp = compare(keyPtr, root->dataPtr);
-    if (comp == 0)
-        return root;
-    else if (comp < 0)
-        return _search(root->left, keyPtr, compare);
-    else
-        return _search(root->right, keyPtr, compare);
+    return root ? root->size : 0;
 }
 
-static void _traverse(NODE *root, void (*callback)(const void *))
+/* keyPtr보다 작은 (inclusive이면 같은 것도 포함) 노드 수
+   오른쪽으로 내려갈 때마다 왼쪽 서브트리와 현재 노드를 더함 */
+static int _rank(TREE *pTree, void *keyPtr, int inclusive)
 {
-    if (!root)
-        return;
-    _traverse(root->left, callback);
-    callback(root->dataPtr);
-    _traverse(root->right, callback);
+    NODE *node = pTree->root;
+    int rank = 0;
+
+    while (node)
+    {
+        int comp = pTree->compare(keyPtr, node->dataPtr);
+        if (comp == 0)
+            return rank + _size(node->left) + (inclusive ? 1 : 0);
+        if (comp < 0)
+            node = node->left;
+        else
+        {
+            rank += _size(node->left) + 1;
+            node = node->right;
+        }
+    }
+    return rank;
 }
 
-static void _traverseR(NODE *root, void (*callback)(const void *))
+/* parent의 자식 oldChild를 newChild로 바꿈 (parent가 NULL이면 root) */
+static void _replaceChild(TREE *pTree, NODE *parent, NODE *oldChild, NODE *newChild)
 {
-    if (!root)
-        return;
-    _traverseR(root->right, callback);
-    callback(root->dataPtr);
-    _traverseR(root->left, callback);
+    if (!parent)
+        pTree->root = newChild;
+    else if (parent->left == oldChild)
+        parent->left = newChild;
+    else
+        parent->right = newChild;
+    if (newChild)
+        newChild->parent = parent;
 }
 
-static void _inorder_print(NODE *root, int level, void (*callback)(const void *))
+/* 트리에서 node를 떼어냄 (해제하지 않음)
+   자식이 두 개인 경우: in-order successor 노드를 node 자리로 옮김 */
+static void _unlink(TREE *pTree, NODE *node)
 {
-    if (!root)
+    NODE *retrace; /* 높이, 크기가 바뀌었을 수 있는 가장 깊은 노드 */
+
+    if (node->left && node->right)
+    {
+        NODE *succ = _first(node->right);
+        if (succ->parent == node)
+            retrace = succ;
+        else
+        {
+            retrace = succ->parent;
+            _replaceChild(pTree, succ->parent, succ, succ->right);
+            succ->right = node->right;
+            succ->right->parent = succ;
+        }
+        succ->left = node->left;
+        succ->left->parent = succ;
+        succ->height = node->height;
+        succ->size = node->size;
+        _replaceChild(pTree, node->parent, node, succ);
+    }
+    else
+    {
+        retrace = node->parent;
+        _replaceChild(pTree, node->parent, node, node->left ? node->left : node->right);
+    }
+
+    /* retrace부터 root까지는 모두 node(또는 옮겨진 succ)를 서브트리에 포함하고 있었음 */
+    for (NODE *p = retrace; p; p = p->parent)
+        p->size--;
+
+    if (pTree->flags & BST_AVL)
+        _rebalance(pTree, retrace);
+}
+
+/* 오른쪽에서 왼쪽으로 in-order 순회하며 깊이만큼 들여쓰기
+   깊이는 아래로 내려갈 때 +1, 위로 올라갈 때 -1 */
+static void _inorder_print(NODE *root, void (*callback)(const void *))
+{
+    NODE *node = root;
+    int level = 0;
+
+    if (!node)
         return;
-    _inorder_print(root->right, level + 1, callback);
-    for (int i = 0; i < level; i++)
-        printf("    ");
-    callback(root->dataPtr);
-    printf("\n");
-    _inorder_print(root->left, level + 1, callback);
+    while (node->right)
+    {
+        node = node->right;
+        level++;
+    }
+
+    while (node)
+    {
+        for (int i = 0; i < level; i++)
+            printf("    ");
+        callback(node->dataPtr);
+        printf("\n");
+
+        /* in-order predecessor로 이동 */
+        if (node->left)
+        {
+            node = node->left;
+            level++;
+            while (node->right)
+            {
+                node = node->right;
+                level++;
+            }
+        }
+        else
+        {
+            while (node->parent && node->parent->left == node)
+            {
+                node = node->parent;
+                level--;
+            }
+            node = node->parent;
+            level--;
+        }
+    }
 }
 
 /* 반환: 트리 내 노드 수 */
@@ -291,3 +591,152 @@ int BST_Count(TREE *pTree)
 {
     return pTree->count;
 }
+
+/*----- AVL helpers (BST_AVL) -----*/
+
+static int _height(NODE *root)
+{
+    return root ? root->height : 0;
+}
+
+static void _updateHeight(NODE *root)
+{
+    int hl = _height(root->left);
+    int hr = _height(root->right);
+    root->height = (hl > hr ? hl : hr) + 1;
+}
+
+static void _updateSize(NODE *root)
+{
+    root->size = _size(root->left) + _size(root->right) + 1;
+}
+
+/* root의 왼쪽 자식을 위로 올림 */
+static NODE *_rotateRight(TREE *pTree, NODE *root)
+{
+    NODE *pivot = root->left;
+    root->left = pivot->right;
+    if (root->left)
+        root->left->parent = root;
+    _replaceChild(pTree, root->parent, root, pivot);
+    pivot->right = root;
+    root->parent = pivot;
+    _updateHeight(root);
+    _updateHeight(pivot);
+    _updateSize(root);
+    _updateSize(pivot);
+    return pivot;
+}
+
+/* root의 오른쪽 자식을 위로 올림 */
+static NODE *_rotateLeft(TREE *pTree, NODE *root)
+{
+    NODE *pivot = root->right;
+    root->right = pivot->left;
+    if (root->right)
+        root->right->parent = root;
+    _replaceChild(pTree, root->parent, root, pivot);
+    pivot->left = root;
+    root->parent = pivot;
+    _updateHeight(root);
+    _updateHeight(pivot);
+    _updateSize(root);
+    _updateSize(pivot);
+    return pivot;
+}
+
+/* node부터 root까지 올라가며 높이를 갱신하고,
+   양쪽 서브트리의 높이 차가 2가 된 노드는 회전으로 복구 */
+static void _rebalance(TREE *pTree, NODE *node)
+{
+    while (node)
+    {
+        _updateHeight(node);
+        int diff = _height(node->left) - _height(node->right);
+
+        if (diff > 1)
+        {
+            /* LR case: 왼쪽 자식을 먼저 회전 */
+            if (_height(node->left->left) < _height(node->left->right))
+                _rotateLeft(pTree, node->left);
+            node = _rotateRight(pTree, node);
+        }
+        else if (diff < -1)
+        {
+            /* RL case: 오른쪽 자식을 먼저 회전 */
+            if (_height(node->right->right) < _height(node->right->left))
+                _rotateRight(pTree, node->right);
+            node = _rotateLeft(pTree, node);
+        }
+        node = node->parent;
+    }
+}
+
+/* snapshot이 있으면 버림 (노드가 추가/삭제되기 직전에 호출) */
+static void _thaw(TREE *pTree)
+{
+    eytz_Destroy(pTree->frozen);
+    pTree->frozen = NULL;
+}
+
+/*----- Bulk build helpers (BST_BuildSorted, BST_Rebalance) -----*/
+
+/* vine에서 scanner 다음의 노드들을 하나 건너 하나씩 왼쪽으로 회전 (count번) */
+static void _compress(NODE *scanner, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        NODE *child = scanner->right;
+        NODE *pivot = child->right;
+
+        scanner->right = pivot;
+        pivot->parent = scanner;
+        child->right = pivot->left;
+        if (child->right)
+            child->right->parent = child;
+        pivot->left = child;
+        child->parent = pivot;
+        scanner = pivot;
+    }
+}
+
+/* pseudo->right에 달린 size개 노드의 vine을 높이가 최소인 트리로 접고 root로 설정
+   vine의 노드는 left가 NULL이고 parent가 vine의 앞 노드여야 함 */
+static void _vineToTree(TREE *pTree, NODE *pseudo, int size)
+{
+    int full = 1;
+
+    /* 마지막 level에 들어갈 잎 노드를 먼저 떼어내고, 나머지는 완전 트리가 되도록 반씩 접음 */
+    while (full * 2 <= size + 1)
+        full *= 2;
+    _compress(pseudo, size + 1 - full);
+    for (size = full - 1; size > 1; size /= 2)
+        _compress(pseudo, size / 2);
+
+    pTree->root = pseudo->right;
+    if (!pTree->root)
+        return;
+    pTree->root->parent = NULL;
+
+    /* post-order로 높이와 서브트리 크기를 다시 계산 (parent 링크로 이동) */
+    NODE *prev = NULL;
+    NODE *node = pTree->root;
+    while (node)
+    {
+        NODE *next;
+        if (prev == node->parent)
+            next = node->left ? node->left : node->right ? node->right : node->parent;
+        else if (prev == node->left && node->right)
+            next = node->right;
+        else
+            next = node->parent;
+
+        if (next == node->parent)
+        {
+            _updateHeight(node);
+            _updateSize(node);
+        }
+        prev = node;
+        node = next;
+    }
+}
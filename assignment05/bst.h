@@ -1,3 +1,6 @@
+#include "pool.h"
+#include "eytz.h"
+
 ////////////////////////////////////////////////////////////////////////////////
 // TREE type definition
 typedef struct node
@@ -5,6 +8,9 @@ typedef struct node
 	void		*dataPtr;
 	struct node	*left;
 	struct node	*right;
+	struct node	*parent;	// 부모 노드 (root는 NULL), 스택 없는 순회에 사용
+	int		height;		// 이 노드를 root로 하는 서브트리의 높이 (BST_AVL)
+	int		size;		// 이 노드를 root로 하는 서브트리의 노드 수 (BST_Select, BST_Rank)
 } NODE;
 
 typedef struct
@@ -12,8 +18,23 @@ typedef struct
 	int	count;
 	NODE	*root;
 	int	(*compare)(const void *, const void *); 
+	int	flags;		// BST_CreateEx의 flags
+	POOL	*pool;		// 노드 allocator (BST_POOL), 아니면 NULL
+	EYTZ	*frozen;	// BST_Freeze로 만든 읽기 전용 snapshot (노드가 추가/삭제되면 NULL)
 } TREE;
 
+// BST_CreateEx flags
+#define BST_AVL		0x1	// AVL 트리: 삽입/삭제 시 균형 유지 (최악의 경우도 O(log n))
+#define BST_POOL	0x2	// 노드를 slab pool에서 할당: 연속된 메모리, BST_Destroy는 slab 단위로 해제
+
+// in-order iterator (BST_IterBegin, BST_IterBeginR, BST_IterNext)
+// 트리에 삽입/삭제가 일어나면 무효가 됨
+typedef struct
+{
+	NODE	*node;		// 다음에 돌려줄 노드
+	int		reverse;	// 1이면 역순 (right-to-left)
+} BST_ITER;
+
 ////////////////////////////////////////////////////////////////////////////////
 // Prototype declarations
 
@@ -23,7 +44,15 @@ typedef struct
 */
 TREE *BST_Create( int (*compare)(const void *, const void *));
 
+/* Same as BST_Create, with options
+	flags	0 (plain BST) or BST_AVL (self-balancing), optionally | BST_POOL
+	return	head node pointer
+			NULL if overflow
+*/
+TREE *BST_CreateEx( int (*compare)(const void *, const void *), int flags);
+
 /* Deletes all data in tree and recycles memory
+	callback이 NULL이면 데이터는 해제하지 않음 (호출한 쪽에서 한꺼번에 해제하는 경우)
 */
 void BST_Destroy( TREE *pTree, void (*callback)(void *));
 
@@ -35,6 +64,19 @@ void BST_Destroy( TREE *pTree, void (*callback)(void *));
 */
 int BST_Insert( TREE *pTree, void *dataInPtr, void (*callback)(void *));
 
+/* Builds a perfectly balanced tree from data sorted in ascending order of key, O(n)
+	트리는 비어 있어야 하고, sorted의 key는 중복 없이 오름차순이어야 함
+	높이는 최소 (floor(log2 n) + 1), BST_AVL 트리에서도 그대로 사용 가능
+	return	1 success
+			0 overflow, tree not empty or data not sorted
+*/
+int BST_BuildSorted( TREE *pTree, void **sorted, int n);
+
+/* Rebuilds the tree in place as a perfectly balanced tree (Day-Stout-Warren), O(n)
+	노드를 새로 할당하지 않음: 회전만으로 오른쪽으로 펼친 뒤(vine) 다시 접음
+*/
+void BST_Rebalance( TREE *pTree);
+
 /* Deletes a node with keyPtr from the tree
 	return	address of data of the node containing the key
 			NULL not found
@@ -42,11 +84,20 @@ int BST_Insert( TREE *pTree, void *dataInPtr, void (*callback)(void *));
 void *BST_Delete( TREE *pTree, void *keyPtr);
 
 /* Retrieve tree for the node containing the requested key (keyPtr)
+	BST_Freeze 이후에는 snapshot에서 찾음
 	return	address of data of the node containing the key
 			NULL not found
 */
 void *BST_Search( TREE *pTree, void *keyPtr);
 
+/* Makes a read-only snapshot of the tree in a contiguous array (eytz.h) for BST_Search, O(n)
+	트리는 그대로 남고, 이후 BST_Insert로 노드가 추가되거나 BST_Delete로 삭제되면 snapshot은 버려짐
+	key		optional order-preserving key of data (see eytz_Create), NULL: compare only
+	return	1 success
+			0 overflow (BST_Search는 트리를 그대로 사용)
+*/
+int BST_Freeze( TREE *pTree, unsigned long long (*key)(const void *));
+
 /* prints tree using inorder traversal
 */
 void BST_Traverse( TREE *pTree, void (*callback)(const void *));
@@ -55,6 +106,22 @@ void BST_Traverse( TREE *pTree, void (*callback)(const void *));
 */
 void BST_TraverseR( TREE *pTree, void (*callback)(const void *));
 
+/* in-order traversal of data whose key is in [loPtr, hiPtr] (both inclusive)
+	범위 밖의 서브트리는 내려가지 않음: O(height + k)
+	return	number of data visited (k)
+*/
+int BST_TraverseRange( TREE *pTree, void *loPtr, void *hiPtr, void (*callback)(const void *));
+
+/* in-order traversal of data matching keyPtr, e.g. words starting with a prefix
+	match(keyPtr, data)는 data가 조건을 만족하면 0,
+	만족하는 data들보다 앞이면 양수, 뒤이면 음수를 반환해야 함
+	(만족하는 data들은 트리의 순서에서 연속되어 있어야 함)
+	ex) 접두사: strncmp(key, word, strlen(key))
+	return	number of data visited, O(height + k)
+*/
+int BST_TraversePrefix( TREE *pTree, void *keyPtr,
+	int (*match)(const void *, const void *), void (*callback)(const void *));
+
 /* Print tree using right-to-left inorder traversal with level
 */
 void printTree( TREE *pTree, void (*callback)(const void *));
@@ -63,3 +130,37 @@ void printTree( TREE *pTree, void (*callback)(const void *));
 */
 int BST_Count( TREE *pTree);
 
+/* Retrieve the k-th smallest data (k = 1 .. BST_Count)
+	서브트리 크기를 따라 내려가므로 O(height)
+	return	address of data
+			NULL if k is out of range
+*/
+void *BST_Select( TREE *pTree, int k);
+
+/* Counts data whose key is smaller than keyPtr (keyPtr가 트리에 없어도 됨)
+	keyPtr가 트리에 있으면 그 순위는 BST_Rank + 1
+	return	number of nodes before keyPtr, O(height)
+*/
+int BST_Rank( TREE *pTree, void *keyPtr);
+
+/* Counts data whose key is in [loPtr, hiPtr] (both inclusive)
+	return	number of nodes in range, O(height)
+			0 if loPtr > hiPtr
+*/
+int BST_CountRange( TREE *pTree, void *loPtr, void *hiPtr);
+
+/* Starts an in-order iteration (smallest key first)
+*/
+void BST_IterBegin( TREE *pTree, BST_ITER *pIter);
+
+/* Starts a right-to-left in-order iteration (largest key first)
+*/
+void BST_IterBeginR( TREE *pTree, BST_ITER *pIter);
+
+/* Returns the next data of the iteration and advances
+	uses parent links only: O(1) extra memory, amortized O(1) per step
+	return	address of data
+			NULL at end of iteration
+*/
+void *BST_IterNext( BST_ITER *pIter);
+
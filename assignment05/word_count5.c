@@ -1,8 +1,14 @@
 #include <stdio.h>
-#include <stdlib.h> // malloc
-#include <string.h> // strdup, strcmp
+#include <stdlib.h> // realloc, free, qsort, strtol
+#include <limits.h> // INT_MIN, INT_MAX
+#include <string.h> // strlen, memcpy, strcmp
 #include <ctype.h>	// toupper
 
+#include "tokenizer.h"
+#include "arena.h"
+#include "batch.h"
+#include "eytz.h"
+
 #include "bst.h"
 
 #define QUIT 1
@@ -12,6 +18,9 @@
 #define SEARCH 5
 #define DELETE 6
 #define COUNT 7
+#define RANK 8
+#define SELECT 9
+#define PREFIX 10
 
 // User structure type definition
 // 단어 구조체
@@ -21,37 +30,40 @@ typedef struct
 	int freq;	// 빈도
 } tWord;
 
+// 단어 구조체와 문자열 저장 공간
+// 트리를 해제한 후 arena_Destroy로 한꺼번에 해제
+static ARENA *wordArena;
+
 ////////////////////////////////////////////////////////////////////////////////
 // 단어 구조체를 위한 메모리를 할당하고 word, freq 초기화
+// 단어 구조체와 문자열은 wordArena에서 한 번에 할당
 // return	할당된 단어 구조체에 대한 pointer
 //			NULL if overflow
 tWord *createWord(char *word)
 {
-	tWord *w = malloc(sizeof(tWord));
+	size_t len = strlen(word);
+	tWord *w = arena_Alloc(wordArena, sizeof(tWord) + len + 1);
 	if (!w)
 		return NULL;
-	w->word = strdup(word);
+	w->word = (char *)(w + 1);
+	memcpy(w->word, word, len + 1);
 	w->freq = 1;
 	return w;
 }
 
 // 단어 구조체에 할당된 메모리를 해제
-// for destroyList function
+// 가장 최근에 할당한 단어만 즉시 반환되고, 나머지는 arena_Destroy에서 해제됨
 void destroyWord(void *pNode)
 {
-	tWord *w = pNode;
-	free(w->word);
-	free(w);
+	arena_Free(wordArena, pNode);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-// gets user's input
-int get_action()
+// converts a menu character to an action
+// for get_action and run_batch functions
+int to_action(int ch)
 {
-	char ch;
-	scanf("%c", &ch);
-	ch = toupper(ch);
-	switch (ch)
+	switch (toupper(ch))
 	{
 	case 'Q':
 		return QUIT;
@@ -67,10 +79,24 @@ int get_action()
 		return DELETE;
 	case 'C':
 		return COUNT;
+	case 'R':
+		return RANK;
+	case 'N':
+		return SELECT;
+	case 'F':
+		return PREFIX;
 	}
 	return 0; // undefined action
 }
 
+// gets user's input
+int get_action()
+{
+	char ch;
+	scanf("%c", &ch);
+	return to_action(ch);
+}
+
 // compares two words in word structures
 // for BST_Create function
 // 정렬 기준 : 단어
@@ -82,6 +108,15 @@ int compare_by_word(const void *n1, const void *n2)
 	return strcmp(p1->word, p2->word);
 }
 
+// data의 단어가 key의 단어로 시작하면 0
+// for BST_TraversePrefix function
+int match_prefix(const void *key, const void *data)
+{
+	const char *prefix = ((tWord *)key)->word;
+
+	return strncmp(prefix, ((tWord *)data)->word, strlen(prefix));
+}
+
 // prints contents of word structure
 // for BST_Traverse and BST_TraverseR functions
 void print_word(const void *dataPtr)
@@ -101,11 +136,184 @@ void increase_freq(void *dataPtr)
 	((tWord *)dataPtr)->freq++;
 }
 
+// 단어의 앞 8 bytes (eytz_StrKey): key가 다르면 문자열을 읽지 않고 비교할 수 있음
+// for BST_Freeze function
+unsigned long long word_key(const void *dataPtr)
+{
+	return eytz_StrKey(((tWord *)dataPtr)->word);
+}
+
+// compares two pointers to word structures
+// for qsort in load_sorted function
+int compare_word_ptr(const void *p1, const void *p2)
+{
+	return compare_by_word(*(tWord **)p1, *(tWord **)p2);
+}
+
+// 모든 단어를 배열에 모은 뒤 정렬하고, 같은 단어는 빈도를 합쳐서 BST_BuildSorted로 한 번에 트리를 만듦
+// 입력이 정렬되어 있어도 트리가 한쪽으로 치우치지 않음
+// return	BST_BuildSorted의 반환값 (1 success, 0 overflow)
+int load_sorted(TREE *tree, TOKENIZER *tok)
+{
+	tWord **words = NULL;
+	int n = 0, capacity = 0;
+	char *token;
+	int ret;
+
+	while ((token = tok_NextWord(tok)) != NULL)
+	{
+		if (n == capacity)
+		{
+			capacity = capacity ? capacity * 2 : 1024;
+			tWord **newWords = realloc(words, capacity * sizeof(tWord *));
+			if (!newWords)
+			{
+				free(words);
+				return 0;
+			}
+			words = newWords;
+		}
+		if ((words[n] = createWord(token)) != NULL)
+			n++;
+	}
+
+	qsort(words, n, sizeof(tWord *), compare_word_ptr);
+
+	int m = 0;
+	for (int i = 0; i < n; i++)
+	{
+		if (m > 0 && compare_by_word(words[m - 1], words[i]) == 0)
+			words[m - 1]->freq += words[i]->freq;
+		else
+			words[m++] = words[i];
+	}
+
+	ret = BST_BuildSorted(tree, (void **)words, m);
+	free(words);
+	return ret;
+}
+
 // gets user's input
 void input_word(char *word)
 {
 	fprintf(stderr, "Input a word to find: ");
-	fscanf(stdin, "%s", word);
+	fscanf(stdin, "%99s", word);
+}
+
+// gets user's input
+// 숫자도 단어로 읽으므로 (%99s) 명령 파일(-q)의 인자와 같은 글자를 받음
+void input_number(char *word)
+{
+	fprintf(stderr, "Input a number: ");
+	fscanf(stdin, "%99s", word);
+}
+
+// converts a word to a number (the whole word must be a decimal integer)
+// for N)th word in the menu and in run_batch
+// return	1 success
+//			0 not a number
+int to_number(const char *word, int *k)
+{
+	char *end;
+	long n = strtol(word, &end, 10);
+
+	if (end == word || *end != '\0' || n < INT_MIN || n > INT_MAX)
+		return 0;
+	*k = (int)n;
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 명령 파일의 명령을 차례로 실행 (Q를 만나면 끝), 출력 형식은 메뉴와 같음
+// 연속된 S)earch는 단어 순으로 정렬하여 찾고 (이웃한 단어를 연달아 찾음), 결과는 원래 순서대로 출력
+// return	실행한 명령 수
+int run_batch(TREE *tree, BATCH *batch)
+{
+	tWord key; // 검색에는 단어만 사용
+	void *ptr;
+	int i = 0;
+
+	while (i < batch->n)
+	{
+		BATCH_CMD *cmd = &batch->cmds[i];
+
+		key.word = cmd->arg;
+		switch (to_action(cmd->action))
+		{
+		case QUIT:
+			return i;
+
+		case FORWARD_PRINT:
+			BST_Traverse(tree, print_word);
+			break;
+
+		case BACKWARD_PRINT:
+			BST_TraverseR(tree, print_word);
+			break;
+
+		case TREE_PRINT:
+			printTree(tree, print_word_only);
+			break;
+
+		case SEARCH:
+		{
+			int run = batch_SortRun(batch, i);
+
+			for (int k = 0; k < run; k++)
+			{
+				key.word = batch->order[k]->arg;
+				batch->order[k]->result = BST_Search(tree, &key);
+			}
+			for (int k = i; k < i + run; k++)
+			{
+				if (batch->cmds[k].result)
+					print_word(batch->cmds[k].result);
+				else
+					fprintf(stdout, "%s not found\n", batch->cmds[k].arg);
+			}
+			i += run;
+			continue;
+		}
+
+		case DELETE:
+			if ((ptr = BST_Delete(tree, &key)) != NULL)
+			{
+				fprintf(stdout, "%s\t%d deleted\n", ((tWord *)ptr)->word, ((tWord *)ptr)->freq);
+				destroyWord(ptr);
+			}
+			else
+				fprintf(stdout, "%s not found\n", cmd->arg);
+			break;
+
+		case COUNT:
+			fprintf(stdout, "%d\n", BST_Count(tree));
+			break;
+
+		case RANK:
+			fprintf(stdout, "%d words before %s\n", BST_Rank(tree, &key), cmd->arg);
+			break;
+
+		case PREFIX:
+			if (BST_TraversePrefix(tree, &key, match_prefix, print_word) == 0)
+				fprintf(stdout, "%s* not found\n", cmd->arg);
+			break;
+
+		case SELECT:
+		{
+			int k;
+
+			if (!to_number(cmd->arg, &k))
+				fprintf(stdout, "%s is not a number\n", cmd->arg);
+			else if ((ptr = BST_Select(tree, k)) != NULL)
+				print_word(ptr);
+			else
+				fprintf(stdout, "%d out of range\n", k);
+			break;
+		}
+		}
+		i++;
+	}
+	return i;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -116,44 +324,115 @@ int main(int argc, char **argv)
 	char word[100];
 	tWord *pWord;
 	int ret;
-	FILE *fp;
+	TOKENIZER *tok;
+	char *token;
+	char *filename = NULL;
+	int flags = 0;
+	int bulk = 0;
+	int rebalance = 0;
+	char *queries = NULL;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-a") == 0)
+			flags |= BST_AVL;
+		else if (strcmp(argv[i], "-b") == 0)
+			bulk = 1;
+		else if (strcmp(argv[i], "-r") == 0)
+			rebalance = 1;
+		else if (strcmp(argv[i], "-q") == 0 && i + 1 < argc)
+			queries = argv[++i];
+		else if (argv[i][0] == '-' || filename)
+		{
+			filename = NULL;
+			break;
+		}
+		else
+			filename = argv[i];
+	}
 
-	if (argc != 2)
+	if (!filename)
 	{
-		fprintf(stderr, "usage: %s FILE\n", argv[0]);
+		fprintf(stderr, "usage: %s [-a] [-b] [-r] [-q QUERIES] FILE\n", argv[0]);
+		fprintf(stderr, "\t-a\tuse a self-balancing (AVL) tree\n");
+		fprintf(stderr, "\t-b\tsort all words first and build a perfectly balanced tree\n");
+		fprintf(stderr, "\t-r\trebalance the tree once after loading (before the menu)\n");
+		fprintf(stderr, "\t-q\trun the menu commands in QUERIES instead of reading stdin\n");
 		return 1;
 	}
 
-	fp = fopen(argv[1], "rt");
-	if (!fp)
+	tok = tok_Open(filename);
+	if (!tok)
 	{
-		fprintf(stderr, "Error: cannot open file [%s]\n", argv[1]);
+		fprintf(stderr, "Error: cannot open file [%s]\n", filename);
 		return 2;
 	}
 
 	// creates an empty tree
-	tree = BST_Create(compare_by_word);
-	if (!tree)
+	wordArena = arena_Create(0);
+	tree = BST_CreateEx(compare_by_word, flags | BST_POOL);
+	if (!tree || !wordArena)
 	{
 		printf("Cannot create a tree\n");
 		return 100;
 	}
 
-	while (fscanf(fp, "%s", word) != EOF)
+	if (bulk)
 	{
-		pWord = createWord(word);
+		if (!load_sorted(tree, tok))
+		{
+			printf("Cannot build a tree\n");
+			return 100;
+		}
+	}
+	else
+	{
+		while ((token = tok_NextWord(tok)) != NULL)
+		{
+			pWord = createWord(token);
 
-		ret = BST_Insert(tree, pWord, increase_freq);
+			ret = BST_Insert(tree, pWord, increase_freq);
 
-		if (ret == 0 || ret == 2) // failure or duplicated
-		{
-			destroyWord(pWord);
+			if (ret == 0 || ret == 2) // failure or duplicated
+			{
+				destroyWord(pWord);
+			}
 		}
+
+		// 삽입 순서로 생긴 트리를 메뉴 전에 한 번 최소 높이로 다시 접음 (노드 할당 없음, O(n))
+		if (rebalance)
+			BST_Rebalance(tree);
 	}
 
-	fclose(fp);
+	tok_Close(tok);
 
-	fprintf(stderr, "Select Q)uit, P)rint, B)ackward print, T)ree print, S)earch, D)elete, C)ount: ");
+	// 메뉴에서는 주로 찾기만 하므로 읽기 전용 snapshot을 만들어 S)earch에 사용 (D)elete 후에는 트리를 사용)
+	BST_Freeze(tree, word_key);
+
+	if (queries)
+	{
+		BATCH *batch = batch_Load(queries, "SDRFN");
+		if (!batch)
+		{
+			fprintf(stderr, "Error: cannot open file [%s]\n", queries);
+			return 2;
+		}
+
+		// 결과는 한꺼번에 출력
+		setvbuf(stdout, NULL, _IOFBF, 1 << 16);
+		double start = batch_Clock();
+		int n = run_batch(tree, batch);
+		fflush(stdout);
+		double sec = batch_Clock() - start;
+		fprintf(stderr, "%d queries in %.3f s (%.0f queries/sec)\n", n, sec, n / (sec > 0 ? sec : 1e-9));
+
+		batch_Destroy(batch);
+		BST_Destroy(tree, NULL);
+		arena_Destroy(wordArena);
+		return 0;
+	}
+
+	fprintf(stderr, "Select Q)uit, P)rint, B)ackward print, T)ree print, S)earch, D)elete, C)ount, R)ank, N)th word, F)ind prefix: ");
 
 	while (1)
 	{
@@ -163,7 +442,9 @@ int main(int argc, char **argv)
 		switch (action)
 		{
 		case QUIT:
-			BST_Destroy(tree, destroyWord);
+			// 단어는 arena와 함께 한꺼번에 해제
+			BST_Destroy(tree, NULL);
+			arena_Destroy(wordArena);
 			return 0;
 
 		case FORWARD_PRINT:
@@ -210,10 +491,41 @@ int main(int argc, char **argv)
 		case COUNT:
 			fprintf(stdout, "%d\n", BST_Count(tree));
 			break;
+
+		case RANK: // 사전 순으로 입력한 단어 앞에 오는 단어 수
+			input_word(word);
+
+			pWord = createWord(word);
+			fprintf(stdout, "%d words before %s\n", BST_Rank(tree, pWord), word);
+			destroyWord(pWord);
+			break;
+
+		case PREFIX: // 입력한 접두사로 시작하는 단어들
+			input_word(word);
+
+			pWord = createWord(word);
+			if (BST_TraversePrefix(tree, pWord, match_prefix, print_word) == 0)
+				fprintf(stdout, "%s* not found\n", word);
+			destroyWord(pWord);
+			break;
+
+		case SELECT: // 사전 순으로 k번째 단어
+		{
+			int k;
+
+			input_number(word);
+			if (!to_number(word, &k))
+				fprintf(stdout, "%s is not a number\n", word);
+			else if ((ptr = BST_Select(tree, k)) != NULL)
+				print_word(ptr);
+			else
+				fprintf(stdout, "%d out of range\n", k);
+			break;
+		}
 		}
 
 		if (action)
-			fprintf(stderr, "Select Q)uit, P)rint, B)ackward print, T)ree print, S)earch, D)elete, C)ount: ");
+			fprintf(stderr, "Select Q)uit, P)rint, B)ackward print, T)ree print, S)earch, D)elete, C)ount, R)ank, N)th word, F)ind prefix: ");
 	}
 	return 0;
 }
@@ -0,0 +1,187 @@
+#include <stdlib.h> // aligned_alloc, free
+#include <unistd.h> // sysconf
+
+#include "adt_cheap.h"
+
+/* Per-thread random state for choosing shards (xorshift64)
+*/
+static __thread unsigned long long _seed;
+
+/* Returns a random shard index
+*/
+static int _randomShard(CHEAP *cheap)
+{
+   if (_seed == 0)
+   {
+      /* Different threads start from different states */
+      _seed = (unsigned long long)(size_t)&_seed * 0x9E3779B97F4A7C15ULL | 1;
+   }
+   _seed ^= _seed << 13;
+   _seed ^= _seed >> 7;
+   _seed ^= _seed << 17;
+   return (int)(_seed % (unsigned long long)cheap->nshards);
+}
+
+/* Allocates a concurrent heap with nshards shards
+*/
+CHEAP *cheap_Create(int (*compare)(const void *arg1, const void *arg2), int nshards)
+{
+   CHEAP *cheap;
+   int i;
+
+   if (nshards <= 0)
+   {
+      long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+      nshards = 4 * (ncpu > 0 ? (int)ncpu : 1);
+   }
+
+   cheap = (CHEAP *)malloc(sizeof(CHEAP));
+   if (cheap == NULL)
+   {
+      return NULL;
+   }
+   cheap->shards = (CHEAP_SHARD *)aligned_alloc(64, nshards * sizeof(CHEAP_SHARD));
+   if (cheap->shards == NULL)
+   {
+      free(cheap);
+      return NULL;
+   }
+   cheap->nshards = 0;
+   cheap->count = 0;
+
+   for (i = 0; i < nshards; i++)
+   {
+      cheap->shards[i].heap = heap_Create(compare);
+      if (cheap->shards[i].heap == NULL)
+      {
+         cheap_Destroy(cheap, NULL);
+         return NULL;
+      }
+      pthread_mutex_init(&cheap->shards[i].lock, NULL);
+      cheap->nshards++;
+   }
+   return cheap;
+}
+
+/* Free memory for heap */
+void cheap_Destroy(CHEAP *cheap, void (*remove_data)(void *ptr))
+{
+   int i;
+
+   if (cheap == NULL)
+      return;
+   for (i = 0; i < cheap->nshards; i++)
+   {
+      heap_Destroy(cheap->shards[i].heap, remove_data);
+      pthread_mutex_destroy(&cheap->shards[i].lock);
+   }
+   free(cheap->shards);
+   free(cheap);
+}
+
+/* Inserts data into a random shard
+   A busy shard is skipped (trylock) so that producers spread out instead of queueing
+*/
+int cheap_Insert(CHEAP *cheap, void *dataPtr)
+{
+   CHEAP_SHARD *shard;
+   int ret;
+
+   if (cheap == NULL || dataPtr == NULL)
+      return 0;
+
+   while (1)
+   {
+      shard = &cheap->shards[_randomShard(cheap)];
+      if (pthread_mutex_trylock(&shard->lock) == 0)
+      {
+         break;
+      }
+   }
+
+   /* count changes under the shard lock, so count > 0 means some shard holds data */
+   ret = heap_Insert(shard->heap, dataPtr);
+   if (ret)
+   {
+      __atomic_add_fetch(&cheap->count, 1, __ATOMIC_RELAXED);
+   }
+   pthread_mutex_unlock(&shard->lock);
+
+   return ret ? 1 : 0;
+}
+
+/* Deletes the larger root of two random shards
+   Both locks are taken with trylock, so two consumers never wait on each other in a cycle
+*/
+int cheap_Delete(CHEAP *cheap, void **dataOutPtr)
+{
+   CHEAP_SHARD *a, *b, *from;
+   int i, ret;
+
+   if (cheap == NULL)
+      return 0;
+
+   while (__atomic_load_n(&cheap->count, __ATOMIC_RELAXED) > 0)
+   {
+      a = &cheap->shards[_randomShard(cheap)];
+      b = &cheap->shards[_randomShard(cheap)];
+      if (pthread_mutex_trylock(&a->lock) != 0)
+      {
+         continue;
+      }
+      if (b == a || pthread_mutex_trylock(&b->lock) != 0)
+      {
+         b = NULL;
+      }
+
+      /* Take the larger root of the shards we hold */
+      from = a;
+      if (b != NULL && !heap_Empty(b->heap)
+          && (heap_Empty(a->heap) || a->heap->compare(b->heap->heapArr[0], a->heap->heapArr[0]) > 0))
+      {
+         from = b;
+      }
+      ret = heap_Delete(from->heap, dataOutPtr);
+      if (ret)
+      {
+         __atomic_sub_fetch(&cheap->count, 1, __ATOMIC_RELAXED);
+      }
+
+      if (b != NULL)
+      {
+         pthread_mutex_unlock(&b->lock);
+      }
+      pthread_mutex_unlock(&a->lock);
+
+      if (ret)
+      {
+         return 1;
+      }
+
+      /* Both picks were empty; sweep every shard before trying random picks again */
+      for (i = 0; i < cheap->nshards; i++)
+      {
+         a = &cheap->shards[i];
+         pthread_mutex_lock(&a->lock);
+         ret = heap_Delete(a->heap, dataOutPtr);
+         if (ret)
+         {
+            __atomic_sub_fetch(&cheap->count, 1, __ATOMIC_RELAXED);
+         }
+         pthread_mutex_unlock(&a->lock);
+         if (ret)
+         {
+            return 1;
+         }
+      }
+   }
+   return 0;
+}
+
+/* return 1 if heap empty; 0 if not */
+int cheap_Empty(CHEAP *cheap)
+{
+   if (cheap == NULL)
+      return 1;
+   return (__atomic_load_n(&cheap->count, __ATOMIC_RELAXED) == 0) ? 1 : 0;
+}
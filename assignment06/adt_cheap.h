@@ -0,0 +1,54 @@
+#ifndef ADT_CHEAP_H
+#define ADT_CHEAP_H
+
+#include <pthread.h>
+
+#include "adt_heap.h"
+
+/* Concurrent priority queue (relaxed multi-queue)
+   Data is spread over several HEAP shards, each with its own lock.
+   Insert goes to a random shard; delete locks two random shards and takes the larger root.
+   Delete therefore returns one of the largest data, not always the largest,
+   in exchange for threads rarely waiting on the same lock.
+*/
+typedef struct
+{
+	pthread_mutex_t	lock;
+	HEAP	*heap;
+} __attribute__((aligned(64))) CHEAP_SHARD;	// one shard per cache line (no false sharing)
+
+typedef struct
+{
+	int	nshards;
+	CHEAP_SHARD *shards;
+	int	count;		// number of data in all shards (updated atomically)
+} CHEAP;
+
+/* Allocates a concurrent heap with nshards shards
+nshards <= 0 selects 4 shards per online CPU (2 to 4 per thread using the queue works well)
+if memory overflow, NULL returned
+*/
+CHEAP *cheap_Create( int (*compare) (const void *arg1, const void *arg2), int nshards);
+
+/* Free memory for heap (no other thread may use it)
+remove_data is called for each remaining element; NULL skips it
+*/
+void cheap_Destroy( CHEAP *cheap, void (*remove_data)(void *ptr));
+
+/* Inserts data into a random shard (thread-safe)
+return 1 if successful; 0 if memory overflow
+*/
+int cheap_Insert( CHEAP *cheap, void *dataPtr);
+
+/* Deletes the larger root of two random shards and passes data back to caller (thread-safe)
+if both are empty, every shard is tried in turn
+return 1 if successful; 0 if all shards empty
+*/
+int cheap_Delete( CHEAP *cheap, void **dataOutPtr);
+
+/*
+return 1 if heap empty; 0 if not (a snapshot; other threads may change it at once)
+*/
+int cheap_Empty( CHEAP *cheap);
+
+#endif
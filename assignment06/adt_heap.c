@@ -1,8 +1,19 @@
 #include <stdio.h>
-#include <stdlib.h> // malloc, realloc, free
+#include <stdlib.h> // malloc, realloc, aligned_alloc, free
+#include <string.h> // memcpy
 
 #include "adt_heap.h"
 
+/* Data and key arrays of a d-ary or keyed heap are aligned so that index 1 starts a cache line;
+   the children of node i (d * i + 1 .. d * i + d) then never straddle a line boundary when d * 8 <= 64
+*/
+#define HEAP_LINE 64
+#define PTR_SLOTS (HEAP_LINE / sizeof(void *))
+#define KEY_SLOTS (HEAP_LINE / sizeof(long long))
+
+/* key of data at index (0 if the heap has no inline keys) */
+#define KEY(heap, index) ((heap)->keyArr != NULL ? (heap)->keyArr[index] : 0)
+
 /* Reestablishes heap by moving data in child up to correct location heap array
    for heap_Insert function
 */
@@ -13,23 +24,77 @@ static void _reheapUp(HEAP *heap, int index);
 */
 static void _reheapDown(HEAP *heap, int index);
 
+/* Compares two data; inline keys decide first and compare only breaks ties
+*/
+static inline int _compare(HEAP *heap, void *a, long long keyA, void *b, long long keyB)
+{
+   if (heap->keyArr != NULL && keyA != keyB)
+   {
+      return (keyA > keyB) ? 1 : -1;
+   }
+   return heap->compare(a, b);
+}
+
+/* Stores data (and its key and handle) at index
+*/
+static inline void _place(HEAP *heap, int index, void *data, long long key, int handle)
+{
+   heap->heapArr[index] = data;
+   if (heap->keyArr != NULL)
+   {
+      heap->keyArr[index] = key;
+   }
+   heap->handleArr[index] = handle;
+   heap->posArr[handle] = index;
+}
+
+/* Moves data (and its key and handle) from index from to index to
+*/
+static inline void _move(HEAP *heap, int to, int from)
+{
+   _place(heap, to, heap->heapArr[from], KEY(heap, from), heap->handleArr[from]);
+}
+
+/* Returns a free handle (handles are 1 .. nextHandle; posArr has room for capacity + 1)
+*/
+static int _newHandle(HEAP *heap)
+{
+   int handle = heap->freeHandle;
+
+   if (handle != 0)
+   {
+      heap->freeHandle = -1 - heap->posArr[handle];
+      return handle;
+   }
+   return ++heap->nextHandle;
+}
+
+/* Releases handle for reuse (free handles are chained through posArr as -1 - next)
+*/
+static void _freeHandle(HEAP *heap, int handle)
+{
+   heap->posArr[handle] = -1 - heap->freeHandle;
+   heap->freeHandle = handle;
+}
+
 /* Reestablishes heap by moving data in child up to correct location in heap array
    for heap_Insert function
+   The data is held aside and parents are moved down into the hole
 */
 static void _reheapUp(HEAP *heap, int index)
 {
    int parent;
-   void *tmp;
+   void *data = heap->heapArr[index];
+   long long key = KEY(heap, index);
+   int handle = heap->handleArr[index];
 
    while (index > 0)
    {
-      parent = (index - 1) / 2;
-      /* If child > parent (max-heap), swap */
-      if (heap->compare(heap->heapArr[index], heap->heapArr[parent]) > 0)
+      parent = (index - 1) / heap->arity;
+      /* If child > parent (max-heap), move parent down */
+      if (_compare(heap, data, key, heap->heapArr[parent], KEY(heap, parent)) > 0)
       {
-         tmp = heap->heapArr[parent];
-         heap->heapArr[parent] = heap->heapArr[index];
-         heap->heapArr[index] = tmp;
+         _move(heap, index, parent);
          index = parent;
       }
       else
@@ -37,52 +102,50 @@ static void _reheapUp(HEAP *heap, int index)
          break;
       }
    }
+   _place(heap, index, data, key, handle);
 }
 
 /* Reestablishes heap by moving data in root down to its correct location in the heap
    for heap_Delete function
+   Of equal children the first one is chosen (left child >= right child selects left)
 */
 static void _reheapDown(HEAP *heap, int index)
 {
-   int left, right, larger;
-   void *tmp;
+   int first, end, larger, child;
+   void *data = heap->heapArr[index];
+   long long key = KEY(heap, index);
+   int handle = heap->handleArr[index];
 
    while (1)
    {
-      left = 2 * index + 1;
-      right = 2 * index + 2;
+      first = heap->arity * index + 1;
 
       /* No children */
-      if (left >= heap->last)
+      if (first >= heap->last)
       {
          break;
       }
 
-      /* Determine which child is larger */
-      if (right < heap->last)
+      /* Determine which child is largest */
+      end = first + heap->arity;
+      if (end > heap->last)
       {
-         /* Both children exist */
-         if (heap->compare(heap->heapArr[left], heap->heapArr[right]) >= 0)
-         {
-            larger = left;
-         }
-         else
-         {
-            larger = right;
-         }
+         end = heap->last;
       }
-      else
+      larger = first;
+      for (child = first + 1; child < end; child++)
       {
-         /* Only left child exists */
-         larger = left;
+         if (_compare(heap, heap->heapArr[child], KEY(heap, child),
+                      heap->heapArr[larger], KEY(heap, larger)) > 0)
+         {
+            larger = child;
+         }
       }
 
-      /* If child > parent, swap */
-      if (heap->compare(heap->heapArr[larger], heap->heapArr[index]) > 0)
+      /* If child > parent, move child up */
+      if (_compare(heap, heap->heapArr[larger], KEY(heap, larger), data, key) > 0)
       {
-         tmp = heap->heapArr[index];
-         heap->heapArr[index] = heap->heapArr[larger];
-         heap->heapArr[larger] = tmp;
+         _move(heap, index, larger);
          index = larger;
       }
       else
@@ -90,6 +153,92 @@ static void _reheapDown(HEAP *heap, int index)
          break;
       }
    }
+   _place(heap, index, data, key, handle);
+}
+
+/* Size in bytes of an aligned block holding capacity elements from index 0
+   (slots - 1 leading elements put index 1 on a line boundary)
+*/
+static size_t _blockSize(int capacity, size_t slots, size_t elemSize)
+{
+   size_t bytes = (slots - 1 + capacity) * elemSize;
+   return (bytes + HEAP_LINE - 1) / HEAP_LINE * HEAP_LINE;
+}
+
+/* Changes the capacity of the heap arrays, keeping the data
+   return 1 if successful; 0 if memory allocation failure
+*/
+static int _resize(HEAP *heap, int capacity)
+{
+   void **newArr;
+   void *arrBlock;
+   void *keyBlock = NULL;
+   int *newHandles;
+
+   /* Handle arrays first; growing them early is harmless if the data arrays fail */
+   newHandles = (int *)realloc(heap->handleArr, capacity * sizeof(int));
+   if (newHandles == NULL)
+   {
+      return 0;
+   }
+   heap->handleArr = newHandles;
+   newHandles = (int *)realloc(heap->posArr, (capacity + 1) * sizeof(int));
+   if (newHandles == NULL)
+   {
+      return 0;
+   }
+   heap->posArr = newHandles;
+
+   /* Plain binary heap: the array is an ordinary malloc block (it may have been adopted by heap_Build) */
+   if (heap->arity == 2 && heap->key == NULL)
+   {
+      newArr = (void **)realloc(heap->heapArr, capacity * sizeof(void *));
+      if (newArr == NULL)
+      {
+         return 0;
+      }
+      heap->heapArr = newArr;
+      heap->capacity = capacity;
+      return 1;
+   }
+
+   /* realloc does not keep the alignment; allocate new blocks and copy */
+   arrBlock = aligned_alloc(HEAP_LINE, _blockSize(capacity, PTR_SLOTS, sizeof(void *)));
+   if (arrBlock == NULL)
+   {
+      return 0;
+   }
+   if (heap->key != NULL)
+   {
+      keyBlock = aligned_alloc(HEAP_LINE, _blockSize(capacity, KEY_SLOTS, sizeof(long long)));
+      if (keyBlock == NULL)
+      {
+         free(arrBlock);
+         return 0;
+      }
+   }
+
+   newArr = (void **)arrBlock + PTR_SLOTS - 1;
+   if (heap->last > 0)
+   {
+      memcpy(newArr, heap->heapArr, heap->last * sizeof(void *));
+   }
+   if (keyBlock != NULL)
+   {
+      if (heap->last > 0)
+      {
+         memcpy((long long *)keyBlock + KEY_SLOTS - 1, heap->keyArr, heap->last * sizeof(long long));
+      }
+      heap->keyArr = (long long *)keyBlock + KEY_SLOTS - 1;
+   }
+
+   free(heap->arrBlock);
+   free(heap->keyBlock);
+   heap->arrBlock = arrBlock;
+   heap->keyBlock = keyBlock;
+   heap->heapArr = newArr;
+   heap->capacity = capacity;
+   return 1;
 }
 
 /* Allocates memory for heap and returns address of heap head structure
@@ -97,6 +246,15 @@ static void _reheapDown(HEAP *heap, int index)
    The initial capacity of the heap should be 10
 */
 HEAP *heap_Create(int (*compare)(const void *arg1, const void *arg2))
+{
+   return heap_CreateEx(compare, 2, NULL);
+}
+
+/* Allocates a d-ary heap, optionally with inline keys
+   if memory overflow, NULL returned
+*/
+HEAP *heap_CreateEx(int (*compare)(const void *arg1, const void *arg2), int arity,
+                    long long (*key)(const void *data))
 {
    HEAP *heap = (HEAP *)malloc(sizeof(HEAP));
    if (heap == NULL)
@@ -104,58 +262,204 @@ HEAP *heap_Create(int (*compare)(const void *arg1, const void *arg2))
       return NULL;
    }
    heap->last = 0;
-   heap->capacity = 10;
+   heap->capacity = 0;
+   heap->heapArr = NULL;
+   heap->compare = compare;
+   heap->arity = (arity < 2) ? 2 : arity;
+   heap->key = key;
+   heap->keyArr = NULL;
+   heap->arrBlock = NULL;
+   heap->keyBlock = NULL;
+   heap->handleArr = NULL;
+   heap->posArr = NULL;
+   heap->nextHandle = 0;
+   heap->freeHandle = 0;
+   if (!_resize(heap, 10))
+   {
+      heap_Destroy(heap, NULL);
+      return NULL;
+   }
+   return heap;
+}
+
+/* Builds a heap from an existing array of n data pointers
+   Floyd's method: reheap down every internal node from the last one up to the root
+   (O(n) in total, compared with O(n log n) for n calls of heap_Insert)
+*/
+HEAP *heap_Build(int (*compare)(const void *arg1, const void *arg2), void **array, int n)
+{
+   int i;
+   HEAP *heap;
+
+   if (array == NULL || n <= 0)
+   {
+      /* Nothing to heapify; an adopted empty array is simply released */
+      heap = heap_Create(compare);
+      if (heap != NULL)
+      {
+         free(array);
+      }
+      return heap;
+   }
+
+   heap = (HEAP *)malloc(sizeof(HEAP));
+   if (heap == NULL)
+   {
+      return NULL;
+   }
+   heap->last = n;
+   heap->capacity = n;
+   heap->heapArr = array;
    heap->compare = compare;
-   heap->heapArr = (void **)malloc(heap->capacity * sizeof(void *));
-   if (heap->heapArr == NULL)
+   heap->arity = 2;
+   heap->key = NULL;
+   heap->keyArr = NULL;
+   heap->arrBlock = NULL;
+   heap->keyBlock = NULL;
+   heap->handleArr = (int *)malloc(n * sizeof(int));
+   heap->posArr = (int *)malloc((n + 1) * sizeof(int));
+   heap->nextHandle = n;
+   heap->freeHandle = 0;
+   if (heap->handleArr == NULL || heap->posArr == NULL)
    {
+      free(heap->handleArr);
+      free(heap->posArr);
       free(heap);
       return NULL;
    }
+
+   /* array[i] gets handle i + 1 */
+   for (i = 0; i < n; i++)
+   {
+      heap->handleArr[i] = i + 1;
+      heap->posArr[i + 1] = i;
+   }
+
+   for (i = n / 2 - 1; i >= 0; i--)
+   {
+      _reheapDown(heap, i);
+   }
    return heap;
 }
 
+/* Sorts the data in place in ascending order of compare and hands the array to the caller
+   Repeatedly moves the root (largest) behind the shrinking heap
+*/
+void **heap_Sort(HEAP *heap, int *n)
+{
+   void **array = NULL;
+   void *data;
+   long long key;
+   int handle;
+   int count;
+
+   if (heap == NULL)
+   {
+      return NULL;
+   }
+
+   /* An aligned array cannot be passed to free; the caller gets a plain copy */
+   if (heap->arrBlock != NULL)
+   {
+      array = (void **)malloc((heap->last > 0 ? heap->last : 1) * sizeof(void *));
+      if (array == NULL)
+      {
+         return NULL;
+      }
+   }
+
+   count = heap->last;
+   while (heap->last > 1)
+   {
+      data = heap->heapArr[0];
+      key = KEY(heap, 0);
+      handle = heap->handleArr[0];
+      heap->last--;
+      _move(heap, 0, heap->last);
+      _reheapDown(heap, 0);
+      _place(heap, heap->last, data, key, handle);
+   }
+
+   /* Detach the array; the next heap_Insert allocates a new one */
+   if (heap->arrBlock != NULL)
+   {
+      if (count > 0)
+      {
+         memcpy(array, heap->heapArr, count * sizeof(void *));
+      }
+      free(heap->arrBlock);
+      free(heap->keyBlock);
+      heap->arrBlock = NULL;
+      heap->keyBlock = NULL;
+      heap->keyArr = NULL;
+   }
+   else
+   {
+      array = heap->heapArr;
+   }
+   heap->heapArr = NULL;
+   heap->capacity = 0;
+   heap->last = 0;
+   heap->nextHandle = 0;
+   heap->freeHandle = 0;
+   *n = count;
+   return array;
+}
+
 /* Free memory for heap */
 void heap_Destroy(HEAP *heap, void (*remove_data)(void *ptr))
 {
    int i;
    if (heap == NULL)
       return;
-   /* Free each data element using provided function */
-   for (i = 0; i < heap->last; i++)
+   /* Free each data element using provided function
+      (NULL if the data is released in bulk by the caller) */
+   if (remove_data != NULL)
+   {
+      for (i = 0; i < heap->last; i++)
+      {
+         remove_data(heap->heapArr[i]);
+      }
+   }
+   if (heap->arrBlock != NULL)
+   {
+      free(heap->arrBlock);
+      free(heap->keyBlock);
+   }
+   else
    {
-      remove_data(heap->heapArr[i]);
+      free(heap->heapArr);
    }
-   free(heap->heapArr);
+   free(heap->handleArr);
+   free(heap->posArr);
    free(heap);
 }
 
 /* Inserts data into heap
-   return 1 if successful; 0 if memory allocation failure
+   return handle of the data (>= 1) if successful; 0 if memory allocation failure
 */
 int heap_Insert(HEAP *heap, void *dataPtr)
 {
-   void **newArr;
+   int handle;
+
    if (heap == NULL || dataPtr == NULL)
       return 0;
 
-   /* If capacity reached, double the array */
+   /* If capacity reached, double the array (an adopted or detached array may have capacity 0) */
    if (heap->last >= heap->capacity)
    {
-      newArr = (void **)realloc(heap->heapArr, (heap->capacity * 2) * sizeof(void *));
-      if (newArr == NULL)
+      if (!_resize(heap, (heap->capacity > 0) ? heap->capacity * 2 : 10))
       {
          return 0;
       }
-      heap->heapArr = newArr;
-      heap->capacity *= 2;
    }
 
    /* Insert at the end and reheap up */
-   heap->heapArr[heap->last] = dataPtr;
+   handle = _newHandle(heap);
+   _place(heap, heap->last, dataPtr, (heap->key != NULL) ? heap->key(dataPtr) : 0, handle);
    _reheapUp(heap, heap->last);
    heap->last++;
-   return 1;
+   return handle;
 }
 
 /* Deletes root of heap and passes data back to caller
@@ -170,12 +474,81 @@ int heap_Delete(HEAP *heap, void **dataOutPtr)
 
    /* Pass root to caller */
    *dataOutPtr = heap->heapArr[0];
+   _freeHandle(heap, heap->handleArr[0]);
 
    /* Move last element to root, shrink, and reheap down */
-   heap->heapArr[0] = heap->heapArr[heap->last - 1];
    heap->last--;
-   _reheapDown(heap, 0);
+   if (heap->last > 0)
+   {
+      _move(heap, 0, heap->last);
+      _reheapDown(heap, 0);
+   }
+
+   return 1;
+}
+
+/* Returns index of the data with handle; -1 if handle is not in the heap
+*/
+static int _index(HEAP *heap, int handle)
+{
+   if (heap == NULL || handle < 1 || handle > heap->nextHandle || heap->posArr[handle] < 0)
+   {
+      return -1;
+   }
+   return heap->posArr[handle];
+}
+
+/* Restores the heap after the data with handle changed its priority
+   Moves it up if it now beats its parent, otherwise down
+*/
+int heap_Update(HEAP *heap, int handle)
+{
+   int index = _index(heap, handle);
 
+   if (index < 0)
+   {
+      return 0;
+   }
+   if (heap->keyArr != NULL)
+   {
+      heap->keyArr[index] = heap->key(heap->heapArr[index]);
+   }
+
+   _reheapUp(heap, index);
+   if (heap->posArr[handle] == index)
+   {
+      _reheapDown(heap, index);
+   }
+   return 1;
+}
+
+/* Deletes the data with handle and passes it back to caller
+   The last element fills the hole and is moved up or down
+*/
+int heap_Remove(HEAP *heap, int handle, void **dataOutPtr)
+{
+   int index = _index(heap, handle);
+   int moved;
+
+   if (index < 0)
+   {
+      return 0;
+   }
+
+   *dataOutPtr = heap->heapArr[index];
+   _freeHandle(heap, handle);
+
+   heap->last--;
+   if (index < heap->last)
+   {
+      moved = heap->handleArr[heap->last];
+      _move(heap, index, heap->last);
+      _reheapUp(heap, index);
+      if (heap->posArr[moved] == index)
+      {
+         _reheapDown(heap, index);
+      }
+   }
    return 1;
 }
 
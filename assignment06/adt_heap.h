@@ -1,9 +1,21 @@
+#ifndef ADT_HEAP_H
+#define ADT_HEAP_H
+
 typedef struct
 {
 	int	last;
 	int	capacity;
 	void **heapArr;
 	int (*compare) (const void *, const void *);
+	int	arity;		// children per node (2 for heap_Create)
+	long long (*key) (const void *);	// inline key of data (NULL: compare only)
+	long long *keyArr;	// keys parallel to heapArr (NULL if key is NULL)
+	void *arrBlock;		// aligned blocks holding heapArr / keyArr (NULL for a plain binary heap)
+	void *keyBlock;
+	int	*handleArr;	// handle of the data at each index
+	int	*posArr;	// index of the data with each handle (-1 - next free handle if unused)
+	int	nextHandle;	// largest handle given out so far
+	int	freeHandle;	// first reusable handle (0 if none)
 } HEAP;
 
 /* Allocates memory for heap and returns address of heap head structure
@@ -12,15 +24,52 @@ The initial capacity of the heap should be 10
 */
 HEAP *heap_Create( int (*compare) (const void *arg1, const void *arg2));
 
+/* Allocates a d-ary heap (arity children per node, 2 if less than 2)
+The arrays are cache-line aligned so that each group of children shares one line (arity 4 or 8)
+key, if not NULL, gives an inline key stored next to each data pointer;
+larger keys come first and compare is called only for equal keys,
+so key must agree with compare (key(a) > key(b) implies compare(a, b) > 0)
+if memory overflow, NULL returned
+*/
+HEAP *heap_CreateEx( int (*compare) (const void *arg1, const void *arg2), int arity,
+	long long (*key) (const void *data));
+
+/* Builds a heap from an existing array of n data pointers in O(n) (bottom-up heapify)
+The heap adopts the array, which must have been allocated with malloc; array[i] gets handle i + 1
+(it is grown with realloc and released by heap_Destroy)
+if memory overflow, NULL returned and the array is left to the caller
+*/
+HEAP *heap_Build( int (*compare) (const void *arg1, const void *arg2), void **array, int n);
+
+/* Sorts the data in place in ascending order of compare and hands the array to the caller
+The heap is left empty (and usable); the caller releases the array with free
+n receives the number of data in the array
+return sorted array; NULL if heap is NULL
+*/
+void **heap_Sort( HEAP *heap, int *n);
+
 /* Free memory for heap
+remove_data is called for each remaining element; NULL skips it
 */
 void heap_Destroy( HEAP *heap, void (*remove_data)(void *ptr));
 
 /* Inserts data into heap
-return 1 if successful; 0 if heap full
+return handle of the data (>= 1) if successful; 0 if heap full
+The handle stays valid until the data leaves the heap and may be reused afterwards
 */
 int heap_Insert( HEAP *heap, void *dataPtr);
 
+/* Restores heap order after the priority of the data with handle changed (O(log n))
+The data itself is updated by the caller before the call; its inline key is recomputed
+return 1 if successful; 0 if handle is not in the heap
+*/
+int heap_Update( HEAP *heap, int handle);
+
+/* Deletes the data with handle and passes it back to caller (O(log n))
+return 1 if successful; 0 if handle is not in the heap
+*/
+int heap_Remove( HEAP *heap, int handle, void **dataOutPtr);
+
 /* Deletes root of heap and passes data back to caller
 return 1 if successful; 0 if heap empty
 */
@@ -34,3 +83,4 @@ int heap_Empty(  HEAP *heap);
 /* Print heap array */
 void heap_Print( HEAP *heap, void (*print_func) (const void *data));
 
+#endif
@@ -1,7 +1,9 @@
 #include <stdio.h>
-#include <string.h> // strdup
+#include <string.h> // strlen, memcpy
 #include <stdlib.h>
 #include "adt_heap.h"
+#include "tokenizer.h"
+#include "arena.h"
 
 // User structure type definition
 // 단어 구조체
@@ -10,17 +12,25 @@ typedef struct {
 	int		freq;		// 빈도
 } tWord;
 
+////////////////////////////////////////////////////////////////////////////////
+// 단어 구조체와 문자열 저장 공간
+// 힙을 해제한 후 arena_Destroy로 한꺼번에 해제
+static ARENA *wordArena;
+
 ////////////////////////////////////////////////////////////////////////////////
 // 단어 구조체를 위한 메모리를 할당하고 word, freq 초기화
+// 단어 구조체와 문자열은 wordArena에서 한 번에 할당
 // return	할당된 단어 구조체에 대한 pointer
 //			NULL if overflow
 tWord *createWord( char *word, int freq)
 {
-	tWord *newWord = malloc( sizeof( tWord));
+	size_t len = strlen( word);
+	tWord *newWord = arena_Alloc( wordArena, sizeof( tWord) + len + 1);
 	
 	if (newWord == NULL) return NULL;
 	
-	newWord->word = strdup( word);
+	newWord->word = (char *)(newWord + 1);
+	memcpy( newWord->word, word, len + 1);
 	newWord->freq = freq;
 	
 	return newWord;
@@ -28,10 +38,10 @@ tWord *createWord( char *word, int freq)
 
 ////////////////////////////////////////////////////////////////////////////////
 // 단어 구조체에 할당된 메모리를 해제
+// 가장 최근에 할당한 단어만 즉시 반환되고, 나머지는 arena_Destroy에서 해제됨
 void destroyWord( void *pWord)
 {
-	free( ((tWord *)pWord)->word);
-	free( pWord);
+	arena_Free( wordArena, pWord);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -64,11 +74,17 @@ int main( int argc, char **argv)
 {
 	HEAP *heap;
 	void *dataPtr;
+	void **words;		// 힙을 한 번에 만들기 위한 단어 배열 (heap_Build가 넘겨받음)
+	int count = 0;
+	int capacity = 10;
+	void **tmp;
 	
-	char word[100];
+	char *word;
+	const char *num;
+	size_t len;
 	int freq;
 	tWord *pWord;
-	FILE *fp;
+	TOKENIZER *tok;
 	
 	if (argc != 2)
 	{
@@ -76,29 +92,56 @@ int main( int argc, char **argv)
 		return 1;
 	}
 		
-	if ((fp = fopen(argv[1], "rt")) == NULL)
+	if ((tok = tok_Open(argv[1])) == NULL)
 	{
 		fprintf( stderr, "file open error: %s\n", argv[1]);
 		return 2;
 	}
 	
-	heap = heap_Create(compare_by_word); // initial capacity = 10
+	wordArena = arena_Create(0);
+	words = (void **)malloc(capacity * sizeof(void *));
+	if (words == NULL)
+	{
+		fprintf( stderr, "out of memory\n");
+		return 1;
+	}
 	
 	printf("Insert:");
 	
-	while(fscanf(fp, "%s\t%d", word, &freq) != EOF)
+	while((word = tok_NextWord(tok)) != NULL)
 	{
+		// 빈도: 단어 다음 토큰 (NUL로 끝나지 않으므로 직접 변환)
+		freq = 0;
+		if (tok_Next(tok, &num, &len))
+			for (size_t i = 0; i < len && num[i] >= '0' && num[i] <= '9'; i++)
+				freq = freq * 10 + (num[i] - '0');
+
 		printf(" %s", word); // 입력 단어
 		pWord = createWord(word, freq);
+		if (pWord == NULL) break;
 		
-		// insert function call
-		if (heap_Insert(heap, pWord) == 0) {
-			destroyWord(pWord);
-			break;
+		if (count == capacity)
+		{
+			tmp = (void **)realloc(words, capacity * 2 * sizeof(void *));
+			if (tmp == NULL) {
+				destroyWord(pWord);
+				break;
+			}
+			words = tmp;
+			capacity *= 2;
 		}
+		words[count++] = pWord;
  	}
 	printf("\n");
-	fclose(fp);
+	tok_Close(tok);
+	
+	// 한 단어씩 heap_Insert하는 대신 모은 배열을 O(n)에 힙으로 만듦
+	heap = heap_Build(compare_by_word, words, count);
+	if (heap == NULL)
+	{
+		fprintf( stderr, "out of memory\n");
+		return 1;
+	}
 	
 	printf("Heap:  ");
 	heap_Print(heap, print_word_only);
@@ -116,7 +159,9 @@ int main( int argc, char **argv)
  	}
 	printf("\n");
 	
-	heap_Destroy(heap, destroyWord);
+	// 단어는 arena와 함께 한꺼번에 해제
+	heap_Destroy(heap, NULL);
+	arena_Destroy(wordArena);
 	
 	return 0;
 }
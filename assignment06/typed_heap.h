@@ -0,0 +1,131 @@
+#ifndef TYPED_HEAP_H
+#define TYPED_HEAP_H
+
+#include <stdlib.h> // malloc, realloc, free
+
+/* Type-specialized max-heap generator
+   Elements are stored by value and compared with an inlinable expression,
+   so there is no per-element allocation, no void * indirection and no call through a function pointer
+
+   TYPED_HEAP(HEAP_TYPE, prefix, T, GREATER)
+      HEAP_TYPE  name of the heap structure type
+      prefix     prefix of the generated functions (prefix_Create, prefix_Insert, ...)
+      T          element type
+      GREATER    function-like macro or static inline function; GREATER(a, b) is nonzero if a goes above b
+
+   Generated functions behave like adt_heap.h:
+      HEAP_TYPE *prefix_Create( void);                       initial capacity 10, NULL if overflow
+      void prefix_Destroy( HEAP_TYPE *heap);
+      int prefix_Insert( HEAP_TYPE *heap, T data);           1 if successful; 0 if overflow
+      int prefix_Delete( HEAP_TYPE *heap, T *dataOutPtr);    1 if successful; 0 if heap empty
+      int prefix_Empty( HEAP_TYPE *heap);
+
+   ex)
+      #define INT_GREATER(a, b) ((a) > (b))
+      TYPED_HEAP(INT_HEAP, intHeap, int, INT_GREATER)
+*/
+#define TYPED_HEAP(HEAP_TYPE, prefix, T, GREATER)                              \
+                                                                               \
+typedef struct                                                                 \
+{                                                                              \
+   int last;                                                                   \
+   int capacity;                                                               \
+   T *heapArr;                                                                 \
+} HEAP_TYPE;                                                                   \
+                                                                               \
+static inline HEAP_TYPE *prefix##_Create(void)                                 \
+{                                                                              \
+   HEAP_TYPE *heap = (HEAP_TYPE *)malloc(sizeof(HEAP_TYPE));                   \
+   if (heap == NULL)                                                           \
+   {                                                                           \
+      return NULL;                                                             \
+   }                                                                           \
+   heap->last = 0;                                                             \
+   heap->capacity = 10;                                                        \
+   heap->heapArr = (T *)malloc(heap->capacity * sizeof(T));                    \
+   if (heap->heapArr == NULL)                                                  \
+   {                                                                           \
+      free(heap);                                                              \
+      return NULL;                                                             \
+   }                                                                           \
+   return heap;                                                                \
+}                                                                              \
+                                                                               \
+static inline void prefix##_Destroy(HEAP_TYPE *heap)                           \
+{                                                                              \
+   if (heap == NULL)                                                           \
+      return;                                                                  \
+   free(heap->heapArr);                                                        \
+   free(heap);                                                                 \
+}                                                                              \
+                                                                               \
+static inline int prefix##_Insert(HEAP_TYPE *heap, T data)                     \
+{                                                                              \
+   int index, parent;                                                          \
+   T *newArr;                                                                  \
+                                                                               \
+   /* If capacity reached, double the array */                                 \
+   if (heap->last >= heap->capacity)                                           \
+   {                                                                           \
+      newArr = (T *)realloc(heap->heapArr, heap->capacity * 2 * sizeof(T));    \
+      if (newArr == NULL)                                                      \
+      {                                                                        \
+         return 0;                                                             \
+      }                                                                        \
+      heap->heapArr = newArr;                                                  \
+      heap->capacity *= 2;                                                     \
+   }                                                                           \
+                                                                               \
+   /* Reheap up: move parents down into the hole */                            \
+   index = heap->last++;                                                       \
+   while (index > 0)                                                           \
+   {                                                                           \
+      parent = (index - 1) / 2;                                                \
+      if (!GREATER(data, heap->heapArr[parent]))                               \
+      {                                                                        \
+         break;                                                                \
+      }                                                                        \
+      heap->heapArr[index] = heap->heapArr[parent];                            \
+      index = parent;                                                          \
+   }                                                                           \
+   heap->heapArr[index] = data;                                                \
+   return 1;                                                                   \
+}                                                                              \
+                                                                               \
+static inline int prefix##_Delete(HEAP_TYPE *heap, T *dataOutPtr)              \
+{                                                                              \
+   int index = 0, child;                                                       \
+   T data;                                                                     \
+                                                                               \
+   if (heap->last == 0)                                                        \
+   {                                                                           \
+      return 0;                                                                \
+   }                                                                           \
+   *dataOutPtr = heap->heapArr[0];                                             \
+   data = heap->heapArr[--heap->last];                                         \
+                                                                               \
+   /* Reheap down: left child unless right child is greater */                 \
+   while ((child = 2 * index + 1) < heap->last)                                \
+   {                                                                           \
+      if (child + 1 < heap->last                                               \
+          && GREATER(heap->heapArr[child + 1], heap->heapArr[child]))          \
+      {                                                                        \
+         child++;                                                              \
+      }                                                                        \
+      if (!GREATER(heap->heapArr[child], data))                                \
+      {                                                                        \
+         break;                                                                \
+      }                                                                        \
+      heap->heapArr[index] = heap->heapArr[child];                             \
+      index = child;                                                           \
+   }                                                                           \
+   heap->heapArr[index] = data;                                                \
+   return 1;                                                                   \
+}                                                                              \
+                                                                               \
+static inline int prefix##_Empty(HEAP_TYPE *heap)                              \
+{                                                                              \
+   return heap == NULL || heap->last == 0;                                     \
+}
+
+#endif
@@ -0,0 +1,80 @@
+// LD_PRELOAD library: counts heap allocations of the process it is loaded into
+// at exit, writes "mallocs N\nreallocs N\nfrees N\nbytes N\n" to the file named by
+// the ALLOC_COUNT_OUT environment variable (glibc only: uses __libc_malloc etc.)
+#include <stdlib.h>
+#include <fcntl.h>	// open
+#include <unistd.h> // write, close
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void __libc_free(void *ptr);
+
+static unsigned long _mallocs, _reallocs, _frees, _bytes;
+
+void *malloc(size_t size)
+{
+	__atomic_add_fetch(&_mallocs, 1, __ATOMIC_RELAXED);
+	__atomic_add_fetch(&_bytes, size, __ATOMIC_RELAXED);
+	return __libc_malloc(size);
+}
+
+void *calloc(size_t nmemb, size_t size)
+{
+	__atomic_add_fetch(&_mallocs, 1, __ATOMIC_RELAXED);
+	__atomic_add_fetch(&_bytes, nmemb * size, __ATOMIC_RELAXED);
+	return __libc_calloc(nmemb, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+	__atomic_add_fetch(ptr ? &_reallocs : &_mallocs, 1, __ATOMIC_RELAXED);
+	__atomic_add_fetch(&_bytes, size, __ATOMIC_RELAXED);
+	return __libc_realloc(ptr, size);
+}
+
+void free(void *ptr)
+{
+	if (ptr)
+		__atomic_add_fetch(&_frees, 1, __ATOMIC_RELAXED);
+	__libc_free(ptr);
+}
+
+// 정수를 10진 문자열로 (stdio는 malloc을 부를 수 있으므로 사용하지 않음)
+static void _writeCount(int fd, const char *name, unsigned long n)
+{
+	char buf[64];
+	int len = 0;
+	char digits[24];
+	int nd = 0;
+
+	while (*name)
+		buf[len++] = *name++;
+	buf[len++] = ' ';
+	do
+	{
+		digits[nd++] = '0' + n % 10;
+		n /= 10;
+	} while (n);
+	while (nd)
+		buf[len++] = digits[--nd];
+	buf[len++] = '\n';
+	if (write(fd, buf, len) < 0)
+		return;
+}
+
+__attribute__((destructor))
+static void _report(void)
+{
+	const char *path = getenv("ALLOC_COUNT_OUT");
+	if (!path)
+		return;
+	int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+		return;
+	_writeCount(fd, "mallocs", _mallocs);
+	_writeCount(fd, "reallocs", _reallocs);
+	_writeCount(fd, "frees", _frees);
+	_writeCount(fd, "bytes", _bytes);
+	close(fd);
+}
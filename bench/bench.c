@@ -0,0 +1,308 @@
+#include <stdio.h>
+#include <stdlib.h>		// atoi, strtol, strtod, setenv
+#include <string.h>		// strcmp, strchr, strncmp
+#include <unistd.h>		// fork, execv, dup2, access
+#include <fcntl.h>		// open
+#include <sys/resource.h>	// struct rusage
+#include <sys/wait.h>	// wait4
+
+#include "zipf.h"
+#include "latency.h"
+#include "bench_adt.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// 비교 대상 엔진
+// program 모드: 과제 실행 파일을 그대로 실행 (전체 시간만 측정)
+// library 모드: bench 자신을 --child로 다시 실행하여 ADT를 직접 호출 (연산별 latency 측정)
+typedef struct
+{
+	const char	*name;
+	const char	*path;		// program 모드: 저장소 기준 경로, library 모드: NULL
+	const char	*option;	// program 모드 추가 인자
+	int			menu;		// 1이면 stdin으로 "q" 입력
+	int			(*run)(const char *corpus, LATENCY *lat);	// library 모드
+} ENGINE;
+
+static const ENGINE engines[] = {
+	{ "array",		"assignment01/word_count",	"-w",	0, NULL },
+	{ "slist",		"assignment02/word_count2",	"-w",	0, NULL },
+	{ "dlist",		"assignment03/word_count3",	NULL,	1, NULL },
+	{ "dlist-adt",	NULL,						NULL,	0, bench_List },
+	{ "bst",		NULL,						NULL,	0, bench_Bst },
+	{ "heap",		NULL,						NULL,	0, bench_Heap },
+};
+
+#define NENGINES (int)(sizeof(engines) / sizeof(engines[0]))
+
+////////////////////////////////////////////////////////////////////////////////
+// 한 번의 측정 결과
+typedef struct
+{
+	double				seconds;
+	long				peak_rss_kb;
+	unsigned long long	mallocs;
+	unsigned long long	frees;
+	long long			p50_ns;		// -1이면 측정하지 않음
+	long long			p99_ns;
+} RESULT;
+
+////////////////////////////////////////////////////////////////////////////////
+static void usage(const char *prog)
+{
+	fprintf(stderr,
+		"usage: %s [-r ROOT] [-n N[,N...]] [-V VOCAB] [-s SKEW] [-e ENGINE[,ENGINE...]] [-t TMPDIR]\n"
+		"  engines: array slist dlist dlist-adt bst heap (default: all)\n"
+		"  build assignment01..03 and bench/alloc_count.so first\n", prog);
+}
+
+// 자식 프로세스: library 모드 엔진 하나를 실행하고 percentile을 파일에 기록
+static int run_child(const char *name, const char *corpus, const char *latfile)
+{
+	static LATENCY lat;
+	int i;
+
+	for (i = 0; i < NENGINES; i++)
+		if (engines[i].run && strcmp(engines[i].name, name) == 0)
+			break;
+	if (i == NENGINES)
+	{
+		fprintf(stderr, "unknown engine: %s\n", name);
+		return 1;
+	}
+
+	lat_Init(&lat);
+	if (engines[i].run(corpus, &lat))
+	{
+		fprintf(stderr, "%s: failed on %s\n", name, corpus);
+		return 1;
+	}
+
+	FILE *fp = fopen(latfile, "w");
+	if (!fp)
+		return 1;
+	fprintf(fp, "%llu %llu\n", lat_Percentile(&lat, 50), lat_Percentile(&lat, 99));
+	fclose(fp);
+	return 0;
+}
+
+// 엔진 하나를 자식 프로세스로 실행하고 시간, 최대 RSS, 할당 횟수를 수집
+static int measure(const ENGINE *e, const char *root, const char *corpus, const char *tmpdir,
+	RESULT *res)
+{
+	char prog[1024], preload[1024], allocfile[1024], latfile[1024], menufile[1024];
+	struct rusage ru;
+	int status;
+
+	snprintf(preload, sizeof(preload), "%s/bench/alloc_count.so", root);
+	snprintf(allocfile, sizeof(allocfile), "%s/alloc.out", tmpdir);
+	snprintf(latfile, sizeof(latfile), "%s/lat.out", tmpdir);
+	snprintf(menufile, sizeof(menufile), "%s/menu.in", tmpdir);
+	remove(allocfile);
+	remove(latfile);
+
+	if (e->path)
+	{
+		snprintf(prog, sizeof(prog), "%s/%s", root, e->path);
+		if (access(prog, X_OK) != 0)
+		{
+			fprintf(stderr, "%s: not built\n", prog);
+			return 1;
+		}
+	}
+	if (e->menu)
+	{
+		FILE *fp = fopen(menufile, "w");
+		if (!fp)
+			return 1;
+		fputs("q\n", fp);
+		fclose(fp);
+	}
+
+	unsigned long long start = lat_Now();
+	pid_t pid = fork();
+	if (pid < 0)
+		return 1;
+	if (pid == 0)
+	{
+		int in = open(e->menu ? menufile : "/dev/null", O_RDONLY);
+		int out = open("/dev/null", O_WRONLY);
+		dup2(in, 0);
+		dup2(out, 1);
+		if (e->menu)
+			dup2(out, 2);	// 메뉴 프롬프트는 stderr로 출력됨
+		if (access(preload, R_OK) == 0)
+			setenv("LD_PRELOAD", preload, 1);
+		setenv("ALLOC_COUNT_OUT", allocfile, 1);
+
+		if (e->path)
+		{
+			char *argv[] = { prog, (char *)e->option, (char *)corpus, NULL };
+			if (!e->option)
+			{
+				argv[1] = (char *)corpus;
+				argv[2] = NULL;
+			}
+			execv(prog, argv);
+		}
+		else
+		{
+			// PATH로 실행되었을 수도 있으므로 자기 자신은 /proc/self/exe로 찾음
+			char *argv[] = { "bench", "--child", (char *)e->name, (char *)corpus, latfile, NULL };
+			execv("/proc/self/exe", argv);
+		}
+		_exit(127);
+	}
+
+	if (wait4(pid, &status, 0, &ru) < 0)
+		return 1;
+	res->seconds = (lat_Now() - start) / 1e9;
+	if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+	{
+		fprintf(stderr, "%s: exited abnormally\n", e->name);
+		return 1;
+	}
+	res->peak_rss_kb = ru.ru_maxrss;
+
+	res->mallocs = res->frees = 0;
+	FILE *fp = fopen(allocfile, "r");
+	if (fp)
+	{
+		if (fscanf(fp, "mallocs %llu reallocs %*u frees %llu", &res->mallocs, &res->frees) != 2)
+			res->mallocs = res->frees = 0;
+		fclose(fp);
+	}
+
+	res->p50_ns = res->p99_ns = -1;
+	fp = fopen(latfile, "r");
+	if (fp)
+	{
+		unsigned long long p50, p99;
+		if (fscanf(fp, "%llu %llu", &p50, &p99) == 2)
+		{
+			res->p50_ns = p50;
+			res->p99_ns = p99;
+		}
+		fclose(fp);
+	}
+	return 0;
+}
+
+static void print_ns(const char *key, long long ns)
+{
+	if (ns < 0)
+		printf(", \"%s\": null", key);
+	else
+		printf(", \"%s\": %lld", key, ns);
+}
+
+// -e 목록에 이름이 있는지 확인 (목록이 NULL이면 전부)
+static int selected(const char *list, const char *name)
+{
+	size_t len = strlen(name);
+	const char *p = list;
+
+	if (!list)
+		return 1;
+	while (p && *p)
+	{
+		if (strncmp(p, name, len) == 0 && (p[len] == ',' || p[len] == '\0'))
+			return 1;
+		p = strchr(p, ',');
+		if (p)
+			p++;
+	}
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+	const char *root = "..";
+	const char *sizes = "10000,100000";
+	const char *only = NULL;
+	const char *tmpdir = "/tmp";
+	int vocab = 10000;
+	double skew = 1.0;
+	char corpus[1024];
+	int i;
+
+	if (argc == 5 && strcmp(argv[1], "--child") == 0)
+		return run_child(argv[2], argv[3], argv[4]);
+
+	for (i = 1; i < argc; i++)
+	{
+		if (i + 1 >= argc)
+		{
+			usage(argv[0]);
+			return 1;
+		}
+		if (strcmp(argv[i], "-r") == 0)
+			root = argv[++i];
+		else if (strcmp(argv[i], "-n") == 0)
+			sizes = argv[++i];
+		else if (strcmp(argv[i], "-V") == 0)
+			vocab = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-s") == 0)
+			skew = strtod(argv[++i], NULL);
+		else if (strcmp(argv[i], "-e") == 0)
+			only = argv[++i];
+		else if (strcmp(argv[i], "-t") == 0)
+			tmpdir = argv[++i];
+		else
+		{
+			usage(argv[0]);
+			return 1;
+		}
+	}
+	if (vocab < 1)
+	{
+		usage(argv[0]);
+		return 1;
+	}
+
+	snprintf(corpus, sizeof(corpus), "%s/bench_corpus.txt", tmpdir);
+
+	for (const char *p = sizes; p && *p; )
+	{
+		long ntokens = strtol(p, NULL, 10);
+		p = strchr(p, ',');
+		if (p)
+			p++;
+		if (ntokens <= 0)
+			continue;
+
+		// 같은 크기에서는 모든 엔진이 같은 말뭉치를 사용
+		ZIPF *zipf = zipf_Create(vocab, skew, 1);
+		FILE *fp = fopen(corpus, "w");
+		if (!zipf || !fp)
+		{
+			fprintf(stderr, "cannot create corpus %s\n", corpus);
+			return 1;
+		}
+		zipf_WriteCorpus(zipf, fp, ntokens, NULL);
+		fclose(fp);
+		zipf_Destroy(zipf);
+
+		for (i = 0; i < NENGINES; i++)
+		{
+			RESULT res;
+
+			if (!selected(only, engines[i].name))
+				continue;
+			if (measure(&engines[i], root, corpus, tmpdir, &res))
+				continue;
+
+			printf("{\"engine\": \"%s\", \"mode\": \"%s\", \"tokens\": %ld, \"vocab\": %d, \"skew\": %g",
+				engines[i].name, engines[i].path ? "program" : "library", ntokens, vocab, skew);
+			printf(", \"seconds\": %.6f, \"tokens_per_sec\": %.0f, \"peak_rss_kb\": %ld",
+				res.seconds, ntokens / (res.seconds > 0 ? res.seconds : 1e-9), res.peak_rss_kb);
+			printf(", \"mallocs\": %llu, \"frees\": %llu", res.mallocs, res.frees);
+			print_ns("p50_ns", res.p50_ns);
+			print_ns("p99_ns", res.p99_ns);
+			printf("}\n");
+			fflush(stdout);
+		}
+	}
+	remove(corpus);
+	return 0;
+}
@@ -0,0 +1,19 @@
+#ifndef BENCH_ADT_H
+#define BENCH_ADT_H
+
+#include "latency.h"
+
+// in-process word counting with the generic ADTs, one timed operation per token
+// return	0 if successful
+//			1 if the corpus cannot be opened or memory overflow
+
+// assignment04 LIST: addNode per token
+int bench_List( const char *corpus, LATENCY *lat);
+
+// assignment05 TREE: BST_Insert per token
+int bench_Bst( const char *corpus, LATENCY *lat);
+
+// assignment06 HEAP: heap_Insert per token, then heap_Delete until empty
+int bench_Heap( const char *corpus, LATENCY *lat);
+
+#endif
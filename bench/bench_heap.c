@@ -0,0 +1,60 @@
+#include <string.h> // memcpy, strcmp
+
+#include "adt_heap.h"
+#include "tokenizer.h"
+#include "arena.h"
+#include "bench_adt.h"
+
+typedef struct
+{
+	char *word;
+	int freq;
+} tWord;
+
+static int compare_by_word(const void *n1, const void *n2)
+{
+	return strcmp(((const tWord *)n1)->word, ((const tWord *)n2)->word);
+}
+
+// 모든 토큰을 힙에 넣은 후 빌 때까지 꺼냄 (run_word_heap과 같은 비교 함수)
+int bench_Heap(const char *corpus, LATENCY *lat)
+{
+	TOKENIZER *tok = tok_Open(corpus);
+	ARENA *arena = arena_Create(0);
+	HEAP *heap = heap_Create(compare_by_word);
+	const char *word;
+	size_t len;
+	void *dataPtr;
+
+	if (!tok || !arena || !heap)
+		return 1;
+
+	while (tok_Next(tok, &word, &len))
+	{
+		tWord *w = (tWord *)arena_Alloc(arena, sizeof(tWord) + len + 1);
+		if (!w)
+			return 1;
+		w->word = (char *)(w + 1);
+		memcpy(w->word, word, len);
+		w->word[len] = '\0';
+		w->freq = 1;
+
+		unsigned long long start = lat_Now();
+		int ret = heap_Insert(heap, w);
+		lat_Add(lat, lat_Now() - start);
+		if (ret == 0)
+			return 1;
+	}
+
+	while (!heap_Empty(heap))
+	{
+		unsigned long long start = lat_Now();
+		heap_Delete(heap, &dataPtr);
+		lat_Add(lat, lat_Now() - start);
+	}
+
+	heap_Destroy(heap, NULL);
+	arena_Destroy(arena);
+	tok_Close(tok);
+	return 0;
+}
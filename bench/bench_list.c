@@ -0,0 +1,58 @@
+#include <string.h> // memcpy, strcmp
+
+#include "adt_dlist.h"
+#include "tokenizer.h"
+#include "arena.h"
+#include "bench_adt.h"
+
+typedef struct
+{
+	char *word;
+	int freq;
+} tWord;
+
+static int compare_by_word(const void *n1, const void *n2)
+{
+	return strcmp(((const tWord *)n1)->word, ((const tWord *)n2)->word);
+}
+
+static void increase_freq(const void *dataPtr)
+{
+	((tWord *)dataPtr)->freq++;
+}
+
+// word_count4와 같은 방식으로 단어를 셈 (pool 노드, arena 단어)
+int bench_List(const char *corpus, LATENCY *lat)
+{
+	TOKENIZER *tok = tok_Open(corpus);
+	ARENA *arena = arena_Create(0);
+	LIST *list = createListEx(compare_by_word, LIST_POOL);
+	const char *word;
+	size_t len;
+
+	if (!tok || !arena || !list)
+		return 1;
+
+	while (tok_Next(tok, &word, &len))
+	{
+		tWord *w = (tWord *)arena_Alloc(arena, sizeof(tWord) + len + 1);
+		if (!w)
+			return 1;
+		w->word = (char *)(w + 1);
+		memcpy(w->word, word, len);
+		w->word[len] = '\0';
+		w->freq = 1;
+
+		unsigned long long start = lat_Now();
+		int ret = addNode(list, w, increase_freq);
+		lat_Add(lat, lat_Now() - start);
+
+		if (ret != 1)
+			arena_Free(arena, w);
+	}
+
+	destroyList(list, NULL);
+	arena_Destroy(arena);
+	tok_Close(tok);
+	return 0;
+}
@@ -0,0 +1,144 @@
+#include <stdio.h>
+#include <stdlib.h> // atoi, malloc, free
+#include <string.h> // strcmp
+#include <pthread.h>
+
+#include "adt_heap.h"
+#include "adt_cheap.h"
+#include "latency.h"
+
+// 여러 스레드가 같은 우선순위 큐에 insert/delete를 섞어 수행할 때의 처리량
+// usage: cheap_bench [-n OPS] [-t MAXTHREADS]
+// 비교 대상: 하나의 mutex로 감싼 HEAP vs CHEAP (샤드별 lock, relaxed multi-queue)
+// 큐를 PREFILL개로 채운 뒤, 각 스레드가 insert 1번 + delete 1번을 반복
+
+#define PREFILL 100000
+
+static int compare_int(const void *a1, const void *a2)
+{
+	return *(const int *)a1 - *(const int *)a2;
+}
+
+typedef struct
+{
+	int kind; // 0: locked HEAP, 1: CHEAP
+	HEAP *heap;
+	pthread_mutex_t *lock;
+	CHEAP *cheap;
+	int *values; // 이 스레드가 넣을 값
+	int nops;
+} tWorker;
+
+static void *worker(void *arg)
+{
+	tWorker *w = (tWorker *)arg;
+	void *dataPtr;
+
+	for (int i = 0; i < w->nops; i++)
+	{
+		if (w->kind == 0)
+		{
+			pthread_mutex_lock(w->lock);
+			heap_Insert(w->heap, &w->values[i]);
+			pthread_mutex_unlock(w->lock);
+
+			pthread_mutex_lock(w->lock);
+			heap_Delete(w->heap, &dataPtr);
+			pthread_mutex_unlock(w->lock);
+		}
+		else
+		{
+			cheap_Insert(w->cheap, &w->values[i]);
+			cheap_Delete(w->cheap, &dataPtr);
+		}
+	}
+	return NULL;
+}
+
+int main(int argc, char **argv)
+{
+	int nops = 1000000;
+	int maxthreads = 32;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+			nops = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+			maxthreads = atoi(argv[++i]);
+		else
+			nops = 0;
+	}
+	if (nops < 1 || maxthreads < 1)
+	{
+		fprintf(stderr, "usage: %s [-n OPS] [-t MAXTHREADS]\n", argv[0]);
+		return 1;
+	}
+
+	int *values = (int *)malloc((size_t)(nops + PREFILL) * sizeof(int));
+	tWorker *workers = (tWorker *)malloc(maxthreads * sizeof(tWorker));
+	pthread_t *threads = (pthread_t *)malloc(maxthreads * sizeof(pthread_t));
+	if (!values || !workers || !threads)
+	{
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	unsigned long long state = 88172645463325252ULL;
+	for (int i = 0; i < nops + PREFILL; i++)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		values[i] = (int)(state % 1000000007ULL);
+	}
+
+	for (int nthreads = 1; nthreads <= maxthreads; nthreads *= 2)
+	{
+		for (int kind = 0; kind < 2; kind++)
+		{
+			pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+			HEAP *heap = NULL;
+			CHEAP *cheap = NULL;
+
+			if (kind == 0)
+				heap = heap_Create(compare_int);
+			else
+				cheap = cheap_Create(compare_int, 4 * nthreads);
+			for (int i = 0; i < PREFILL; i++)
+			{
+				if (kind == 0)
+					heap_Insert(heap, &values[nops + i]);
+				else
+					cheap_Insert(cheap, &values[nops + i]);
+			}
+
+			int per = nops / nthreads;
+			unsigned long long start = lat_Now();
+			for (int t = 0; t < nthreads; t++)
+			{
+				workers[t].kind = kind;
+				workers[t].heap = heap;
+				workers[t].lock = &lock;
+				workers[t].cheap = cheap;
+				workers[t].values = values + (size_t)t * per;
+				workers[t].nops = per;
+				pthread_create(&threads[t], NULL, worker, &workers[t]);
+			}
+			for (int t = 0; t < nthreads; t++)
+				pthread_join(threads[t], NULL);
+			double sec = (lat_Now() - start) / 1e9;
+
+			printf("{\"queue\": \"%s\", \"threads\": %d, \"ops\": %d, \"ops_per_sec\": %.0f}\n",
+				   kind == 0 ? "locked-heap" : "cheap", nthreads, per * nthreads * 2, per * nthreads * 2 / sec);
+			fflush(stdout);
+
+			heap_Destroy(heap, NULL);
+			cheap_Destroy(cheap, NULL);
+		}
+	}
+
+	free(values);
+	free(workers);
+	free(threads);
+	return 0;
+}
@@ -0,0 +1,169 @@
+#include <stdio.h>
+#include <stdlib.h> // atoi, malloc, free
+#include <string.h> // strcmp, memcpy
+
+#include "adt_heap.h"
+#include "tokenizer.h"
+#include "arena.h"
+#include "latency.h"
+
+// 힙 레이아웃별 insert / delete-max 처리량 비교
+// usage: heap_bench [-x SCALE] [-r ROUNDS] FILE
+// FILE은 run_word_heap의 입력 형식("단어 빈도"), SCALE배로 복제하여 사용 (복제본마다 단어 뒤에 번호를 붙임)
+
+typedef struct
+{
+	char *word;
+	int freq;
+} tWord;
+
+// 빈도가 높을수록 먼저 나옴 (빈도가 같으면 단어 오름차순)
+static int compare_by_freq(const void *n1, const void *n2)
+{
+	const tWord *w1 = (const tWord *)n1;
+	const tWord *w2 = (const tWord *)n2;
+	if (w1->freq != w2->freq)
+		return (w1->freq > w2->freq) ? 1 : -1;
+	return strcmp(w2->word, w1->word);
+}
+
+static long long key_by_freq(const void *data)
+{
+	return ((const tWord *)data)->freq;
+}
+
+typedef struct
+{
+	const char *name;
+	int arity;
+	long long (*key)(const void *);
+} LAYOUT;
+
+static const LAYOUT layouts[] = {
+	{ "binary", 2, NULL },
+	{ "4-ary", 4, NULL },
+	{ "8-ary", 8, NULL },
+	{ "4-ary+key", 4, key_by_freq },
+	{ "8-ary+key", 8, key_by_freq },
+};
+
+int main(int argc, char **argv)
+{
+	int scale = 100;
+	int rounds = 3;
+	char *filename = NULL;
+	TOKENIZER *tok;
+	ARENA *arena;
+	tWord **words;
+	int nwords = 0, capacity = 1024;
+	const char *word, *num;
+	size_t len, nlen;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-x") == 0 && i + 1 < argc)
+			scale = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+			rounds = atoi(argv[++i]);
+		else if (argv[i][0] != '-')
+			filename = argv[i];
+		else
+			filename = NULL, i = argc;
+	}
+	if (filename == NULL || scale < 1 || rounds < 1)
+	{
+		fprintf(stderr, "usage: %s [-x SCALE] [-r ROUNDS] FILE\n", argv[0]);
+		return 1;
+	}
+	if ((tok = tok_Open(filename)) == NULL)
+	{
+		fprintf(stderr, "cannot open file : %s\n", filename);
+		return 1;
+	}
+
+	// 단어를 SCALE번 복제 ("word", "word#1", "word#2", ...)
+	arena = arena_Create(0);
+	words = (tWord **)malloc(capacity * sizeof(tWord *));
+	while (tok_Next(tok, &word, &len) && tok_Next(tok, &num, &nlen))
+	{
+		int freq = 0;
+		for (size_t i = 0; i < nlen && num[i] >= '0' && num[i] <= '9'; i++)
+			freq = freq * 10 + (num[i] - '0');
+
+		for (int c = 0; c < scale; c++)
+		{
+			if (nwords == capacity)
+			{
+				capacity *= 2;
+				words = (tWord **)realloc(words, capacity * sizeof(tWord *));
+			}
+			tWord *w = (tWord *)arena_Alloc(arena, sizeof(tWord) + len + 12);
+			if (w == NULL || words == NULL)
+			{
+				fprintf(stderr, "out of memory\n");
+				return 1;
+			}
+			w->word = (char *)(w + 1);
+			memcpy(w->word, word, len);
+			if (c > 0)
+				snprintf(w->word + len, 12, "#%d", c);
+			else
+				w->word[len] = '\0';
+			w->freq = freq;
+			words[nwords++] = w;
+		}
+	}
+	tok_Close(tok);
+
+	// 복제본이 이어지지 않도록 섞음 (xorshift, 고정 seed)
+	unsigned long long state = 88172645463325252ULL;
+	for (int i = nwords - 1; i > 0; i--)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		int j = (int)(state % (unsigned long long)(i + 1));
+		tWord *tmp = words[i];
+		words[i] = words[j];
+		words[j] = tmp;
+	}
+
+	for (size_t l = 0; l < sizeof(layouts) / sizeof(layouts[0]); l++)
+	{
+		double best_insert = 0, best_delete = 0;
+		unsigned long long check = 0;
+
+		for (int r = 0; r < rounds; r++)
+		{
+			HEAP *heap = heap_CreateEx(compare_by_freq, layouts[l].arity, layouts[l].key);
+			void *dataPtr;
+			unsigned long long start, mid, end;
+
+			start = lat_Now();
+			for (int i = 0; i < nwords; i++)
+				heap_Insert(heap, words[i]);
+			mid = lat_Now();
+
+			// 삭제 순서는 레이아웃과 무관해야 하므로 순서에 의존하는 체크섬을 계산
+			check = 0;
+			while (heap_Delete(heap, &dataPtr))
+				check = check * 31 + ((tWord *)dataPtr)->freq + (unsigned long long)(((tWord *)dataPtr)->word[0]);
+			end = lat_Now();
+			heap_Destroy(heap, NULL);
+
+			double ins = nwords / ((mid - start) / 1e9);
+			double del = nwords / ((end - mid) / 1e9);
+			if (ins > best_insert)
+				best_insert = ins;
+			if (del > best_delete)
+				best_delete = del;
+		}
+
+		printf("{\"layout\": \"%s\", \"items\": %d, \"insert_per_sec\": %.0f, \"delete_max_per_sec\": %.0f, \"check\": \"%016llx\"}\n",
+			   layouts[l].name, nwords, best_insert, best_delete, check);
+	}
+
+	free(words);
+	arena_Destroy(arena);
+	return 0;
+}
@@ -0,0 +1,56 @@
+#include <string.h> // memset
+#include <time.h>	// clock_gettime
+
+#include "latency.h"
+
+void lat_Init(LATENCY *lat)
+{
+	memset(lat, 0, sizeof(LATENCY));
+}
+
+unsigned long long lat_Now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// bucket: ns < 16이면 ns 그대로, 아니면 (최상위 비트 위치, 그 아래 4비트)
+static int _bucket(unsigned long long ns)
+{
+	if (ns < 16)
+		return (int)ns;
+	int msb = 63 - __builtin_clzll(ns);
+	return (msb - 3) * 16 + (int)((ns >> (msb - 4)) & 15);
+}
+
+// bucket의 하한값
+static unsigned long long _value(int bucket)
+{
+	if (bucket < 16)
+		return bucket;
+	int msb = bucket / 16 + 3;
+	return (16ULL + bucket % 16) << (msb - 4);
+}
+
+void lat_Add(LATENCY *lat, unsigned long long ns)
+{
+	lat->count[_bucket(ns)]++;
+	lat->total++;
+}
+
+unsigned long long lat_Percentile(const LATENCY *lat, double p)
+{
+	unsigned long long rank = (unsigned long long)(lat->total * p / 100.0);
+	unsigned long long seen = 0;
+
+	if (rank == 0)
+		rank = 1;
+	for (int i = 0; i < LAT_BUCKETS; i++)
+	{
+		seen += lat->count[i];
+		if (seen >= rank)
+			return _value(i);
+	}
+	return 0;
+}
@@ -0,0 +1,35 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+////////////////////////////////////////////////////////////////////////////////
+// LATENCY type definition
+// 연산별 소요 시간(ns)의 log-linear histogram
+// 2의 거듭제곱 구간마다 16개의 bucket (상대 오차 약 6% 이하)
+#define LAT_BUCKETS (61 * 16)
+
+typedef struct
+{
+	unsigned long long	count[LAT_BUCKETS];
+	unsigned long long	total;	// 기록된 연산 수
+} LATENCY;
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototype declarations
+
+/* Clears the histogram
+*/
+void lat_Init( LATENCY *lat);
+
+/* Returns a monotonic timestamp in ns
+*/
+unsigned long long lat_Now( void);
+
+/* Records one operation that took ns nanoseconds
+*/
+void lat_Add( LATENCY *lat, unsigned long long ns);
+
+/* Returns the latency at percentile p (0 < p <= 100), lower bound of the bucket
+*/
+unsigned long long lat_Percentile( const LATENCY *lat, double p);
+
+#endif
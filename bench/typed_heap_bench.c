@@ -0,0 +1,180 @@
+#include <stdio.h>
+#include <stdlib.h> // atoi, malloc, free
+#include <string.h> // strcmp
+
+#include "adt_heap.h"
+#include "typed_heap.h"
+#include "latency.h"
+
+// 범용 HEAP(void *, compare 함수 포인터)과 typed_heap.h로 만든 값 저장 힙의 비교
+// usage: typed_heap_bench [-n COUNT] [-r ROUNDS]
+// int 힙: run_int_heap처럼 원소마다 malloc한 int vs int 값 그대로
+// (freq, word) 힙: tWord 포인터 + compare 함수 vs {freq, word} 구조체 값
+
+typedef struct
+{
+	int freq;
+	const char *word;
+} tWord;
+
+static int compare_int(const void *a1, const void *a2)
+{
+	return *(const int *)a1 - *(const int *)a2;
+}
+
+// 빈도가 높을수록 먼저 나옴 (빈도가 같으면 단어 오름차순)
+static int compare_by_freq(const void *n1, const void *n2)
+{
+	const tWord *w1 = (const tWord *)n1;
+	const tWord *w2 = (const tWord *)n2;
+	if (w1->freq != w2->freq)
+		return (w1->freq > w2->freq) ? 1 : -1;
+	return strcmp(w2->word, w1->word);
+}
+
+#define INT_GREATER(a, b) ((a) > (b))
+TYPED_HEAP(INT_HEAP, intHeap, int, INT_GREATER)
+
+static inline int word_greater(tWord a, tWord b)
+{
+	if (a.freq != b.freq)
+		return a.freq > b.freq;
+	return strcmp(b.word, a.word) > 0;
+}
+TYPED_HEAP(WORD_HEAP, wordHeap, tWord, word_greater)
+
+static void report(const char *name, int n, unsigned long long ins_ns, unsigned long long del_ns,
+				   unsigned long long check)
+{
+	printf("{\"heap\": \"%s\", \"items\": %d, \"insert_per_sec\": %.0f, \"delete_max_per_sec\": %.0f, \"check\": \"%016llx\"}\n",
+		   name, n, n / (ins_ns / 1e9), n / (del_ns / 1e9), check);
+}
+
+int main(int argc, char **argv)
+{
+	int n = 1000000;
+	int rounds = 3;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+			n = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+			rounds = atoi(argv[++i]);
+		else
+			n = 0;
+	}
+	if (n < 1 || rounds < 1)
+	{
+		fprintf(stderr, "usage: %s [-n COUNT] [-r ROUNDS]\n", argv[0]);
+		return 1;
+	}
+
+	// 입력: 난수 int, 그리고 작은 빈도(동률이 많음)와 서로 다른 단어
+	int *values = (int *)malloc(n * sizeof(int));
+	tWord *words = (tWord *)malloc(n * sizeof(tWord));
+	char *text = (char *)malloc((size_t)n * 8);
+	unsigned long long state = 88172645463325252ULL;
+	if (!values || !words || !text)
+	{
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	for (int i = 0; i < n; i++)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		values[i] = (int)(state % 1000000007ULL);
+
+		char *w = text + (size_t)i * 8;
+		unsigned long long r = state >> 20;
+		for (int c = 0; c < 7; c++, r /= 26)
+			w[c] = 'a' + r % 26;
+		w[7] = '\0';
+		words[i].word = w;
+		words[i].freq = 1 + (int)(state % 64) / (1 + (int)(state >> 58));
+	}
+
+	for (int kind = 0; kind < 4; kind++)
+	{
+		unsigned long long best_ins = ~0ULL, best_del = ~0ULL, check = 0;
+		const char *name[] = { "generic int (malloc per item)", "typed int", "generic (freq, word)", "typed (freq, word)" };
+
+		for (int r = 0; r < rounds; r++)
+		{
+			unsigned long long t0, t1, t2;
+			void *dataPtr;
+			check = 0;
+
+			if (kind == 0)
+			{
+				HEAP *heap = heap_Create(compare_int);
+				t0 = lat_Now();
+				for (int i = 0; i < n; i++)
+				{
+					int *p = (int *)malloc(sizeof(int));
+					*p = values[i];
+					heap_Insert(heap, p);
+				}
+				t1 = lat_Now();
+				while (heap_Delete(heap, &dataPtr))
+				{
+					check = check * 31 + *(int *)dataPtr;
+					free(dataPtr);
+				}
+				t2 = lat_Now();
+				heap_Destroy(heap, NULL);
+			}
+			else if (kind == 1)
+			{
+				INT_HEAP *heap = intHeap_Create();
+				int v;
+				t0 = lat_Now();
+				for (int i = 0; i < n; i++)
+					intHeap_Insert(heap, values[i]);
+				t1 = lat_Now();
+				while (intHeap_Delete(heap, &v))
+					check = check * 31 + v;
+				t2 = lat_Now();
+				intHeap_Destroy(heap);
+			}
+			else if (kind == 2)
+			{
+				HEAP *heap = heap_Create(compare_by_freq);
+				t0 = lat_Now();
+				for (int i = 0; i < n; i++)
+					heap_Insert(heap, &words[i]);
+				t1 = lat_Now();
+				while (heap_Delete(heap, &dataPtr))
+					check = check * 31 + ((tWord *)dataPtr)->freq + ((tWord *)dataPtr)->word[0];
+				t2 = lat_Now();
+				heap_Destroy(heap, NULL);
+			}
+			else
+			{
+				WORD_HEAP *heap = wordHeap_Create();
+				tWord w;
+				t0 = lat_Now();
+				for (int i = 0; i < n; i++)
+					wordHeap_Insert(heap, words[i]);
+				t1 = lat_Now();
+				while (wordHeap_Delete(heap, &w))
+					check = check * 31 + w.freq + w.word[0];
+				t2 = lat_Now();
+				wordHeap_Destroy(heap);
+			}
+
+			if (t1 - t0 < best_ins)
+				best_ins = t1 - t0;
+			if (t2 - t1 < best_del)
+				best_del = t2 - t1;
+		}
+		report(name[kind], n, best_ins, best_del, check);
+	}
+
+	free(values);
+	free(words);
+	free(text);
+	return 0;
+}
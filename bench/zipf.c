@@ -0,0 +1,111 @@
+#include <stdlib.h> // malloc, free
+#include <math.h>	// pow
+
+#include "zipf.h"
+
+// xorshift64*: 64-bit 난수
+static unsigned long long _rand64(ZIPF *zipf)
+{
+	unsigned long long x = zipf->state;
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	zipf->state = x;
+	return x * 0x2545F4914F6CDD1DULL;
+}
+
+ZIPF *zipf_Create(int vocab, double skew, unsigned long long seed)
+{
+	ZIPF *zipf = (ZIPF *)malloc(sizeof(ZIPF));
+	if (!zipf)
+		return NULL;
+	zipf->cdf = (double *)malloc(vocab * sizeof(double));
+	if (!zipf->cdf)
+	{
+		free(zipf);
+		return NULL;
+	}
+	zipf->vocab = vocab;
+	zipf->state = seed ? seed : 0x9E3779B97F4A7C15ULL;
+
+	double sum = 0.0;
+	for (int r = 0; r < vocab; r++)
+	{
+		sum += 1.0 / pow(r + 1, skew);
+		zipf->cdf[r] = sum;
+	}
+	for (int r = 0; r < vocab; r++)
+		zipf->cdf[r] /= sum;
+	zipf->cdf[vocab - 1] = 1.0;
+	return zipf;
+}
+
+void zipf_Destroy(ZIPF *zipf)
+{
+	if (!zipf)
+		return;
+	free(zipf->cdf);
+	free(zipf);
+}
+
+// 균등 난수 u에 대해 cdf[r] >= u인 가장 작은 r (이진 탐색)
+int zipf_Next(ZIPF *zipf)
+{
+	double u = (_rand64(zipf) >> 11) * (1.0 / 9007199254740992.0);
+	int low = 0, high = zipf->vocab - 1;
+	while (low < high)
+	{
+		int mid = (low + high) / 2;
+		if (zipf->cdf[mid] < u)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+	return low;
+}
+
+// 앞의 두 글자는 rank의 해시, 나머지는 rank의 26진 표기
+// 앞 두 글자의 길이가 고정이므로 rank마다 다른 단어가 됨
+int zipf_Word(int rank, char *buf)
+{
+	unsigned h = (unsigned)rank * 2654435761u;
+	int len = 0;
+
+	buf[len++] = 'a' + (h >> 16) % 26;
+	buf[len++] = 'a' + (h >> 24) % 26;
+	do
+	{
+		buf[len++] = 'a' + rank % 26;
+		rank /= 26;
+	} while (rank > 0);
+	buf[len] = '\0';
+	return len;
+}
+
+void zipf_WriteCorpus(ZIPF *zipf, FILE *fp, long ntokens, long *counts)
+{
+	char word[16];
+
+	for (long i = 0; i < ntokens; i++)
+	{
+		int rank = zipf_Next(zipf);
+		if (counts)
+			counts[rank]++;
+		zipf_Word(rank, word);
+		fputs(word, fp);
+		fputc((i % 12 == 11 || i == ntokens - 1) ? '\n' : ' ', fp);
+	}
+}
+
+void zipf_WriteFreq(FILE *fp, int vocab, const long *counts)
+{
+	char word[16];
+
+	for (int r = 0; r < vocab; r++)
+	{
+		if (counts[r] == 0)
+			continue;
+		zipf_Word(r, word);
+		fprintf(fp, "%s\t%ld\n", word, counts[r]);
+	}
+}
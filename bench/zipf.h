@@ -0,0 +1,48 @@
+#ifndef ZIPF_H
+#define ZIPF_H
+
+#include <stdio.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// ZIPF type definition
+// 어휘 크기 vocab, 지수 skew인 Zipf 분포에서 단어 순위(rank)를 뽑는 generator
+// rank r (0-based)의 확률 ∝ 1 / (r + 1)^skew
+typedef struct
+{
+	int		vocab;
+	double	*cdf;		// 누적 분포 (cdf[vocab - 1] == 1.0)
+	unsigned long long	state;	// xorshift64* 상태
+} ZIPF;
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototype declarations
+
+/* Allocates a generator
+	return	generator pointer
+			NULL if overflow
+*/
+ZIPF *zipf_Create( int vocab, double skew, unsigned long long seed);
+
+void zipf_Destroy( ZIPF *zipf);
+
+/* Draws the next rank (0 .. vocab - 1)
+*/
+int zipf_Next( ZIPF *zipf);
+
+/* Writes the word of rank into buf (at least 16 bytes)
+	words are unique per rank and their alphabetical order is unrelated to rank
+	return	length of the word
+*/
+int zipf_Word( int rank, char *buf);
+
+/* Writes ntokens words (12 per line) to fp
+	counts	if not NULL, counts[rank] is incremented for every word written
+*/
+void zipf_WriteCorpus( ZIPF *zipf, FILE *fp, long ntokens, long *counts);
+
+/* Writes "word\tfreq" lines for every rank with counts[rank] > 0
+	(input format of run_word_heap)
+*/
+void zipf_WriteFreq( FILE *fp, int vocab, const long *counts);
+
+#endif
@@ -0,0 +1,64 @@
+#include <stdio.h>
+#include <stdlib.h> // atol, atof, calloc
+#include <string.h> // strcmp
+
+#include "zipf.h"
+
+// Zipf 분포를 따르는 단어 corpus 생성
+// usage: zipf_gen [-n TOKENS] [-V VOCAB] [-s SKEW] [-S SEED] [-f FREQFILE]
+int main(int argc, char **argv)
+{
+	long ntokens = 100000;
+	int vocab = 50000;
+	double skew = 1.0;
+	unsigned long long seed = 1;
+	char *freqFile = NULL;
+	long *counts = NULL;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+			ntokens = atol(argv[++i]);
+		else if (strcmp(argv[i], "-V") == 0 && i + 1 < argc)
+			vocab = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+			skew = atof(argv[++i]);
+		else if (strcmp(argv[i], "-S") == 0 && i + 1 < argc)
+			seed = strtoull(argv[++i], NULL, 10);
+		else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc)
+			freqFile = argv[++i];
+		else
+		{
+			fprintf(stderr, "usage: %s [-n TOKENS] [-V VOCAB] [-s SKEW] [-S SEED] [-f FREQFILE]\n", argv[0]);
+			fprintf(stderr, "\twrites TOKENS words to stdout; -f also writes \"word\\tfreq\" lines\n");
+			return 1;
+		}
+	}
+
+	ZIPF *zipf = zipf_Create(vocab, skew, seed);
+	if (freqFile)
+		counts = (long *)calloc(vocab, sizeof(long));
+	if (!zipf || (freqFile && !counts))
+	{
+		fprintf(stderr, "out of memory\n");
+		return 100;
+	}
+
+	zipf_WriteCorpus(zipf, stdout, ntokens, counts);
+
+	if (freqFile)
+	{
+		FILE *fp = fopen(freqFile, "w");
+		if (!fp)
+		{
+			fprintf(stderr, "cannot open file : %s\n", freqFile);
+			return 2;
+		}
+		zipf_WriteFreq(fp, vocab, counts);
+		fclose(fp);
+	}
+
+	free(counts);
+	zipf_Destroy(zipf);
+	return 0;
+}
@@ -0,0 +1,116 @@
+#include <stdlib.h> // malloc, free
+#include <string.h> // memcpy
+
+#include "arena.h"
+
+#define ARENA_DEFAULT_BLOCK (64 * 1024)
+#define ARENA_ALIGN 16
+
+// rounds size up to a multiple of ARENA_ALIGN
+#define ALIGN_UP(n) (((n) + (ARENA_ALIGN - 1)) & ~(size_t)(ARENA_ALIGN - 1))
+
+// block header size, rounded so that data starts aligned
+#define HEADER_SIZE ALIGN_UP(sizeof(ARENA_BLOCK))
+
+// internal function
+// allocates a block with at least size bytes of data and links it into the arena
+// big requests get a dedicated block behind the current one so the rest of
+// the current block is not wasted
+// return	start of the data area
+//			NULL if overflow
+static char *_newBlock(ARENA *arena, size_t size)
+{
+	int dedicated = size > arena->blockSize / 4;
+	size_t dataSize = dedicated ? size : arena->blockSize;
+
+	ARENA_BLOCK *block = (ARENA_BLOCK *)malloc(HEADER_SIZE + dataSize);
+	if (!block)
+		return NULL;
+	block->size = dataSize;
+	arena->nblocks++;
+
+	char *data = (char *)block + HEADER_SIZE;
+	if (dedicated && arena->block)
+	{
+		block->next = arena->block->next;
+		arena->block->next = block;
+		return data;
+	}
+
+	block->next = arena->block;
+	arena->block = block;
+	arena->cur = data;
+	arena->end = data + dataSize;
+	return data;
+}
+
+ARENA *arena_Create(size_t blockSize)
+{
+	ARENA *arena = (ARENA *)malloc(sizeof(ARENA));
+	if (!arena)
+		return NULL;
+	arena->block = NULL;
+	arena->cur = arena->end = arena->last = NULL;
+	arena->blockSize = blockSize ? ALIGN_UP(blockSize) : ARENA_DEFAULT_BLOCK;
+	arena->used = 0;
+	arena->nblocks = 0;
+	return arena;
+}
+
+void arena_Destroy(ARENA *arena)
+{
+	if (!arena)
+		return;
+	ARENA_BLOCK *block = arena->block;
+	while (block)
+	{
+		ARENA_BLOCK *next = block->next;
+		free(block);
+		block = next;
+	}
+	free(arena);
+}
+
+void *arena_Alloc(ARENA *arena, size_t size)
+{
+	size = ALIGN_UP(size ? size : 1);
+
+	if ((size_t)(arena->end - arena->cur) < size)
+	{
+		char *data = _newBlock(arena, size);
+		if (!data)
+			return NULL;
+		if (data != arena->cur)
+		{
+			// dedicated block: not the bump region, cannot be given back
+			arena->last = NULL;
+			arena->used += size;
+			return data;
+		}
+	}
+
+	arena->last = arena->cur;
+	arena->cur += size;
+	arena->used += size;
+	return arena->last;
+}
+
+char *arena_StrDup(ARENA *arena, const char *str, size_t len)
+{
+	char *copy = (char *)arena_Alloc(arena, len + 1);
+	if (!copy)
+		return NULL;
+	memcpy(copy, str, len);
+	copy[len] = '\0';
+	return copy;
+}
+
+void arena_Free(ARENA *arena, void *ptr)
+{
+	if (ptr && ptr == arena->last)
+	{
+		arena->used -= arena->cur - arena->last;
+		arena->cur = arena->last;
+		arena->last = NULL;
+	}
+}
@@ -0,0 +1,58 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h> // size_t
+
+////////////////////////////////////////////////////////////////////////////////
+// ARENA type definition
+// bump-pointer allocator: 큰 블록을 잘라서 나눠주고, arena_Destroy에서 한꺼번에 해제
+typedef struct arenablock
+{
+	struct arenablock	*next;	// 이전에 할당된 블록
+	size_t	size;				// data의 크기 (bytes)
+} ARENA_BLOCK;
+
+typedef struct
+{
+	ARENA_BLOCK	*block;		// 현재 블록 (블록 리스트의 head)
+	char	*cur;			// 현재 블록에서 다음에 나눠줄 위치
+	char	*end;			// 현재 블록의 끝
+	char	*last;			// 가장 최근에 나눠준 메모리 (arena_Free용)
+	size_t	blockSize;		// 새 블록의 기본 크기
+	size_t	used;			// 나눠준 전체 바이트 수
+	int		nblocks;		// 할당한 블록 수
+} ARENA;
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototype declarations
+
+/* Allocates an empty arena
+	blockSize	size of each block (0: default 64KB)
+	return	arena pointer
+			NULL if overflow
+*/
+ARENA *arena_Create( size_t blockSize);
+
+/* Frees every block, and with them every allocation made from the arena
+*/
+void arena_Destroy( ARENA *arena);
+
+/* Allocates size bytes aligned for any type
+	return	pointer to memory
+			NULL if overflow
+*/
+void *arena_Alloc( ARENA *arena, size_t size);
+
+/* Copies len bytes of str into the arena and appends '\0'
+	return	copied string
+			NULL if overflow
+*/
+char *arena_StrDup( ARENA *arena, const char *str, size_t len);
+
+/* Gives back ptr if it is the most recent allocation (e.g. a duplicated key
+	that was not inserted); otherwise does nothing and the memory is
+	reclaimed by arena_Destroy
+*/
+void arena_Free( ARENA *arena, void *ptr);
+
+#endif
@@ -0,0 +1,148 @@
+#include <stdlib.h> // malloc, realloc, free, qsort
+#include <string.h> // strchr, strcmp
+#include <ctype.h>  // toupper
+#include <time.h>   // clock_gettime
+
+#include "batch.h"
+#include "tokenizer.h"
+
+#define BATCH_ARG_MAX 99 // 인자의 최대 길이 (대화형 메뉴의 word[100])
+
+// internal function
+// appends a command (grows the array by doubling)
+// return	1 success
+//			0 overflow
+static int _append(BATCH *batch, int *capacity, int action, char *arg)
+{
+	if (batch->n == *capacity)
+	{
+		int newCapacity = *capacity ? *capacity * 2 : 1024;
+		BATCH_CMD *newCmds = (BATCH_CMD *)realloc(batch->cmds, newCapacity * sizeof(BATCH_CMD));
+		if (!newCmds)
+			return 0;
+		batch->cmds = newCmds;
+		*capacity = newCapacity;
+	}
+	batch->cmds[batch->n].action = action;
+	batch->cmds[batch->n].arg = arg;
+	batch->cmds[batch->n].result = NULL;
+	batch->n++;
+	return 1;
+}
+
+// internal function
+// 대화형 메뉴와 같은 규칙으로 읽음
+// 명령은 한 글자씩 (get_action), 인자는 명령 글자 바로 뒤에 남은 글자이거나 다음 단어 (fscanf "%99s")
+// 인자는 최대 BATCH_ARG_MAX 글자이고, 단어에 남은 글자는 "%99s"처럼 다음 명령으로 읽음
+// return	1 success
+//			0 overflow
+static int _parse(BATCH *batch, TOKENIZER *tok, const char *withArg)
+{
+	int capacity = 0;
+	const char *word;
+	size_t len;
+
+	while (tok_Next(tok, &word, &len))
+	{
+		for (size_t i = 0; i < len; i++)
+		{
+			int action = toupper((unsigned char)word[i]);
+			char *arg = NULL;
+
+			// strchr는 끝의 NUL도 찾으므로 NUL 글자는 인자를 받는 명령이 아님
+			if (action != 0 && strchr(withArg, action))
+			{
+				if (++i == len)
+				{
+					if (!tok_Next(tok, &word, &len))
+						return 1; // 인자 없이 끝난 명령은 버림
+					i = 0;
+				}
+				size_t n = len - i < BATCH_ARG_MAX ? len - i : BATCH_ARG_MAX;
+				arg = arena_StrDup(batch->arena, word + i, n);
+				if (!arg)
+					return 0;
+				i += n - 1; // 인자 다음 글자부터 다시 명령
+			}
+			if (!_append(batch, &capacity, action, arg))
+				return 0;
+		}
+	}
+	return 1;
+}
+
+BATCH *batch_Load(const char *filename, const char *withArg)
+{
+	TOKENIZER *tok = tok_Open(filename);
+	BATCH *batch = (BATCH *)malloc(sizeof(BATCH));
+	int ok;
+
+	if (!tok || !batch)
+	{
+		tok_Close(tok);
+		free(batch);
+		return NULL;
+	}
+	batch->n = 0;
+	batch->cmds = NULL;
+	batch->order = NULL;
+	batch->arena = arena_Create(0);
+
+	ok = batch->arena && _parse(batch, tok, withArg);
+	if (ok)
+	{
+		batch->order = (BATCH_CMD **)malloc((batch->n + 1) * sizeof(BATCH_CMD *));
+		ok = batch->order != NULL;
+	}
+	tok_Close(tok);
+	if (!ok)
+	{
+		batch_Destroy(batch);
+		return NULL;
+	}
+	return batch;
+}
+
+void batch_Destroy(BATCH *batch)
+{
+	if (!batch)
+		return;
+	free(batch->cmds);
+	free(batch->order);
+	arena_Destroy(batch->arena);
+	free(batch);
+}
+
+// internal function
+// compares two commands by argument; equal arguments keep the file order
+static int _compareArg(const void *p1, const void *p2)
+{
+	const BATCH_CMD *c1 = *(const BATCH_CMD **)p1;
+	const BATCH_CMD *c2 = *(const BATCH_CMD **)p2;
+	int ret = strcmp(c1->arg, c2->arg);
+	if (ret != 0)
+		return ret;
+	return (c1 > c2) - (c1 < c2);
+}
+
+int batch_SortRun(BATCH *batch, int first)
+{
+	int action = batch->cmds[first].action;
+	int run = 0;
+
+	while (first + run < batch->n && batch->cmds[first + run].action == action)
+	{
+		batch->order[run] = &batch->cmds[first + run];
+		run++;
+	}
+	if (batch->cmds[first].arg)
+		qsort(batch->order, run, sizeof(BATCH_CMD *), _compareArg);
+	return run;
+}
+
+double batch_Clock(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
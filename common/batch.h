@@ -0,0 +1,50 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "arena.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// BATCH type definition
+// 메뉴 명령 파일 (ex. assignment05/menu.txt)을 한 번에 읽어 둔 것
+// 형식은 대화형 메뉴의 입력과 같음: 명령 문자 하나씩, 인자를 받는 명령은 그 뒤의 단어가 인자
+typedef struct
+{
+	int		action;		// 명령 문자 (대문자)
+	char	*arg;		// 인자 (withArg의 명령만), 없으면 NULL
+	void	*result;	// 실행 결과 (검색 결과를 순서대로 출력하기 전까지 보관)
+} BATCH_CMD;
+
+typedef struct
+{
+	int			n;			// 명령 수
+	BATCH_CMD	*cmds;
+	BATCH_CMD	**order;	// batch_SortRun이 채우는 명령 (인자 순)
+	ARENA		*arena;		// 인자 문자열
+} BATCH;
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototype declarations
+
+/* Reads every command of the file
+	withArg	명령 문자 중 인자를 받는 것 (ex. "SD")
+	return	batch pointer
+			NULL if the file cannot be opened or memory overflow
+*/
+BATCH *batch_Load( const char *filename, const char *withArg);
+
+/* Frees the commands and their arguments
+*/
+void batch_Destroy( BATCH *batch);
+
+/* Finds the run of consecutive commands that have the same action as cmds[first]
+	and sorts them by argument (strcmp) into batch->order[0 .. run - 1]
+	정렬된 순서로 실행하면 이웃한 key를 연달아 찾게 됨 (finger, cache의 지역성)
+	return	length of the run
+*/
+int batch_SortRun( BATCH *batch, int first);
+
+/* Returns a monotonic time in seconds (for queries/sec)
+*/
+double batch_Clock( void);
+
+#endif
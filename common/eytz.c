@@ -0,0 +1,115 @@
+#include <stdlib.h> // aligned_alloc, free
+
+#include "eytz.h"
+
+#define EYTZ_LINE 64 // cache line size (bytes)
+
+// internal function
+// allocates count elements of size bytes aligned to a cache line
+// (aligned_alloc needs a size that is a multiple of the alignment)
+static void *_allocLines(size_t count, size_t size)
+{
+	size_t bytes = (count * size + EYTZ_LINE - 1) / EYTZ_LINE * EYTZ_LINE;
+	return aligned_alloc(EYTZ_LINE, bytes);
+}
+
+EYTZ *eytz_Create(void **sorted, int n, int (*compare)(const void *, const void *),
+	unsigned long long (*key)(const void *))
+{
+	EYTZ *snap = (EYTZ *)malloc(sizeof(EYTZ));
+	if (!snap)
+		return NULL;
+	snap->n = n;
+	snap->compare = compare;
+	snap->key = key;
+	snap->dataArr = (void **)_allocLines(n + 1, sizeof(void *));
+	snap->keyArr = key ? (unsigned long long *)_allocLines(n + 1, sizeof(unsigned long long)) : NULL;
+	if (!snap->dataArr || (key && !snap->keyArr))
+	{
+		eytz_Destroy(snap);
+		return NULL;
+	}
+
+	// 암시적 트리를 in-order로 방문하면서 정렬된 순서대로 채움
+	// 시작은 가장 왼쪽 노드, 다음 노드는 오른쪽 서브트리의 가장 왼쪽이거나
+	// 왼쪽 자식으로 올라온 첫 조상
+	int k = 1;
+	while (2 * k <= n)
+		k *= 2;
+	for (int i = 0; i < n; i++)
+	{
+		snap->dataArr[k] = sorted[i];
+		if (key)
+			snap->keyArr[k] = key(sorted[i]);
+
+		if (2 * k + 1 <= n)
+		{
+			k = 2 * k + 1;
+			while (2 * k <= n)
+				k *= 2;
+		}
+		else
+		{
+			while (k & 1)
+				k >>= 1;
+			k >>= 1;
+		}
+	}
+	return snap;
+}
+
+void eytz_Destroy(EYTZ *snap)
+{
+	if (!snap)
+		return;
+	free(snap->dataArr);
+	free(snap->keyArr);
+	free(snap);
+}
+
+// 찾는 key보다 크면 오른쪽(2k + 1), 아니면 왼쪽(2k)으로 내려가고 같아도 멈추지 않음
+// 끝까지 내려간 k에서 마지막으로 왼쪽으로 간 위치가 keyPtr 이상인 첫 데이터 (lower bound)
+// 8 * k는 3 level 아래 자손 8개가 모인 cache line이므로 미리 prefetch
+void *eytz_Search(EYTZ *snap, const void *keyPtr)
+{
+	int n = snap->n;
+	int k = 1;
+
+	if (snap->keyArr)
+	{
+		unsigned long long key = snap->key(keyPtr);
+		while (k <= n)
+		{
+			__builtin_prefetch(snap->keyArr + 8 * k);
+			unsigned long long cur = snap->keyArr[k];
+			int comp = (key > cur) - (key < cur);
+			if (comp == 0)
+				comp = snap->compare(keyPtr, snap->dataArr[k]);
+			k = 2 * k + (comp > 0);
+		}
+	}
+	else
+	{
+		while (k <= n)
+		{
+			__builtin_prefetch(snap->dataArr + 8 * k);
+			k = 2 * k + (snap->compare(keyPtr, snap->dataArr[k]) > 0);
+		}
+	}
+
+	k >>= __builtin_ffs(~k);
+	if (k && snap->compare(keyPtr, snap->dataArr[k]) == 0)
+		return snap->dataArr[k];
+	return NULL;
+}
+
+unsigned long long eytz_StrKey(const char *s)
+{
+	const unsigned char *p = (const unsigned char *)s;
+	unsigned long long key = 0;
+	int i;
+
+	for (i = 0; i < 8 && p[i]; i++)
+		key = key << 8 | p[i];
+	return i ? key << (8 * (8 - i)) : 0;
+}
@@ -0,0 +1,46 @@
+#ifndef EYTZ_H
+#define EYTZ_H
+
+////////////////////////////////////////////////////////////////////////////////
+// EYTZ type definition
+// 정렬된 데이터의 읽기 전용 snapshot (트리/리스트의 freeze)
+// 데이터를 Eytzinger 순서(완전 이진 트리를 level 순으로 펼친 배열)로 저장: i번의 자식은 2i, 2i+1 (1-based)
+// 위쪽 level이 배열 앞쪽의 몇 cache line에 모이고, 몇 level 아래의 위치를 미리 prefetch할 수 있음
+typedef struct
+{
+	int		n;			// 데이터 수
+	void	**dataArr;	// [1..n] Eytzinger 순서의 데이터
+	unsigned long long	*keyArr;	// [1..n] dataArr의 정렬 key (key 함수가 없으면 NULL)
+	int		(*compare)(const void *, const void *);
+	unsigned long long	(*key)(const void *);
+} EYTZ;
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototype declarations
+
+/* Builds a snapshot from data sorted in ascending order (no duplicated keys), O(n)
+	key		optional order-preserving key (NULL: compare only)
+			key(a) < key(b)이면 compare(a, b) < 0이어야 함 (ex. 문자열의 앞 8 bytes)
+			key가 같을 때만 compare를 호출하므로 데이터를 따라가는 횟수가 줄어듦
+	return	snapshot pointer
+			NULL if overflow
+*/
+EYTZ *eytz_Create( void **sorted, int n, int (*compare)(const void *, const void *),
+	unsigned long long (*key)(const void *));
+
+/* Frees the snapshot (not the data)
+*/
+void eytz_Destroy( EYTZ *snap);
+
+/* Searches keyPtr without branching on the comparison result
+	return	address of data with the same key
+			NULL not found
+*/
+void *eytz_Search( EYTZ *snap, const void *keyPtr);
+
+/* Returns the first 8 bytes of s as a big-endian integer (zero padded if shorter)
+	strcmp와 같은 순서를 주는 key (key 함수를 만들 때 사용)
+*/
+unsigned long long eytz_StrKey( const char *s);
+
+#endif
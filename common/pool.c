@@ -0,0 +1,85 @@
+#include <stdlib.h> // malloc, free
+
+#include "pool.h"
+
+#define POOL_DEFAULT_SLAB (64 * 1024)
+#define POOL_ALIGN 16
+
+// rounds n up to a multiple of POOL_ALIGN
+#define ALIGN_UP(n) (((n) + (POOL_ALIGN - 1)) & ~(size_t)(POOL_ALIGN - 1))
+
+// slab header size, rounded so that objects start aligned
+#define HEADER_SIZE ALIGN_UP(sizeof(POOL_SLAB))
+
+POOL *pool_Create(size_t objSize, int perSlab)
+{
+	POOL *pool = (POOL *)malloc(sizeof(POOL));
+	if (!pool)
+		return NULL;
+
+	// free list의 링크를 객체 안에 저장하므로 최소 포인터 크기
+	if (objSize < sizeof(void *))
+		objSize = sizeof(void *);
+	pool->objSize = ALIGN_UP(objSize);
+	if (perSlab <= 0)
+	{
+		perSlab = (int)((POOL_DEFAULT_SLAB - HEADER_SIZE) / pool->objSize);
+		if (perSlab < 1)
+			perSlab = 1;
+	}
+	pool->perSlab = perSlab;
+	pool->slabs = NULL;
+	pool->cur = pool->end = NULL;
+	pool->freeList = NULL;
+	pool->nslabs = 0;
+	return pool;
+}
+
+void pool_Destroy(POOL *pool)
+{
+	if (!pool)
+		return;
+	POOL_SLAB *slab = pool->slabs;
+	while (slab)
+	{
+		POOL_SLAB *next = slab->next;
+		free(slab);
+		slab = next;
+	}
+	free(pool);
+}
+
+void *pool_Alloc(POOL *pool)
+{
+	// 반환된 객체를 먼저 재사용
+	if (pool->freeList)
+	{
+		void *ptr = pool->freeList;
+		pool->freeList = *(void **)ptr;
+		return ptr;
+	}
+
+	if (pool->cur == pool->end)
+	{
+		POOL_SLAB *slab = (POOL_SLAB *)malloc(HEADER_SIZE + pool->objSize * pool->perSlab);
+		if (!slab)
+			return NULL;
+		slab->next = pool->slabs;
+		pool->slabs = slab;
+		pool->nslabs++;
+		pool->cur = (char *)slab + HEADER_SIZE;
+		pool->end = pool->cur + pool->objSize * pool->perSlab;
+	}
+
+	void *ptr = pool->cur;
+	pool->cur += pool->objSize;
+	return ptr;
+}
+
+void pool_Free(POOL *pool, void *ptr)
+{
+	if (!ptr)
+		return;
+	*(void **)ptr = pool->freeList;
+	pool->freeList = ptr;
+}
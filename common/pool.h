@@ -0,0 +1,50 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stddef.h> // size_t
+
+////////////////////////////////////////////////////////////////////////////////
+// POOL type definition
+// 같은 크기의 객체(트리/리스트 노드)를 slab 단위로 연속 할당하는 allocator
+// 해제된 객체는 free list로 재사용하고, pool_Destroy에서 slab을 한꺼번에 해제
+typedef struct poolslab
+{
+	struct poolslab	*next;	// 이전에 할당된 slab
+} POOL_SLAB;
+
+typedef struct
+{
+	size_t	objSize;	// 객체 크기 (정렬 단위로 올림)
+	int		perSlab;	// slab 하나에 들어가는 객체 수
+	POOL_SLAB	*slabs;	// slab 리스트의 head
+	char	*cur;		// 현재 slab에서 다음에 나눠줄 위치
+	char	*end;		// 현재 slab의 끝
+	void	*freeList;	// pool_Free로 반환된 객체 (첫 word가 다음 객체를 가리킴)
+	int		nslabs;		// 할당한 slab 수
+} POOL;
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototype declarations
+
+/* Allocates an empty pool for objects of objSize bytes
+	perSlab	objects per slab (0: as many as fit in 64KB)
+	return	pool pointer
+			NULL if overflow
+*/
+POOL *pool_Create( size_t objSize, int perSlab);
+
+/* Frees every slab, and with them every object of the pool
+*/
+void pool_Destroy( POOL *pool);
+
+/* Allocates one object
+	return	pointer to object
+			NULL if overflow
+*/
+void *pool_Alloc( POOL *pool);
+
+/* Returns one object to the pool for reuse
+*/
+void pool_Free( POOL *pool, void *ptr);
+
+#endif
@@ -0,0 +1,348 @@
+#include <stdlib.h> // malloc, realloc, free, getenv
+#include <string.h> // memcpy, strcmp
+#include <fcntl.h>	// open
+#include <unistd.h> // read, close
+#include <sys/mman.h> // mmap, munmap, madvise
+#include <sys/stat.h> // fstat
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h> // SSE2, AVX2 intrinsics
+#define TOK_X86 1
+#endif
+
+#include "tokenizer.h"
+
+// fscanf "%s"와 같은 공백 문자 판별 (C locale의 isspace)
+#define IS_SPACE(c) ((c) == ' ' || (unsigned)((unsigned char)(c) - '\t') < 5u)
+
+////////////////////////////////////////////////////////////////////////////////
+// whitespace scanners
+// _skipSpace_scalar: returns the first non-space byte in [p, end) (or end)
+// _findSpace_scalar: returns the first space byte in [p, end) (or end)
+
+static const char *_skipSpace_scalar(const char *p, const char *end)
+{
+	while (p < end && IS_SPACE(*p))
+		p++;
+	return p;
+}
+
+static const char *_findSpace_scalar(const char *p, const char *end)
+{
+	while (p < end && !IS_SPACE(*p))
+		p++;
+	return p;
+}
+
+#ifdef TOK_X86
+// bit i set if byte i of the 16-byte block is a space
+// ' ' 이거나 '\t'..'\r' (x - 9를 부호 없는 값으로 보고 4 이하)
+static inline unsigned _spaceMask_sse2(__m128i x)
+{
+	__m128i t = _mm_sub_epi8(x, _mm_set1_epi8('\t'));
+	__m128i ctrl = _mm_cmpeq_epi8(_mm_min_epu8(t, _mm_set1_epi8(4)), t);
+	__m128i blank = _mm_cmpeq_epi8(x, _mm_set1_epi8(' '));
+	return (unsigned)_mm_movemask_epi8(_mm_or_si128(ctrl, blank));
+}
+
+// classifies the 64 bytes at p: bit i set if p[i] is a space
+static unsigned long long _classify_sse2(const char *p)
+{
+	unsigned long long m0 = _spaceMask_sse2(_mm_loadu_si128((const __m128i *)p));
+	unsigned long long m1 = _spaceMask_sse2(_mm_loadu_si128((const __m128i *)(p + 16)));
+	unsigned long long m2 = _spaceMask_sse2(_mm_loadu_si128((const __m128i *)(p + 32)));
+	unsigned long long m3 = _spaceMask_sse2(_mm_loadu_si128((const __m128i *)(p + 48)));
+	return m0 | (m1 << 16) | (m2 << 32) | (m3 << 48);
+}
+
+__attribute__((target("avx2")))
+static inline unsigned _spaceMask_avx2(__m256i x)
+{
+	__m256i t = _mm256_sub_epi8(x, _mm256_set1_epi8('\t'));
+	__m256i ctrl = _mm256_cmpeq_epi8(_mm256_min_epu8(t, _mm256_set1_epi8(4)), t);
+	__m256i blank = _mm256_cmpeq_epi8(x, _mm256_set1_epi8(' '));
+	return (unsigned)_mm256_movemask_epi8(_mm256_or_si256(ctrl, blank));
+}
+
+__attribute__((target("avx2")))
+static unsigned long long _classify_avx2(const char *p)
+{
+	unsigned long long lo = _spaceMask_avx2(_mm256_loadu_si256((const __m256i *)p));
+	unsigned long long hi = _spaceMask_avx2(_mm256_loadu_si256((const __m256i *)(p + 32)));
+	return lo | (hi << 32);
+}
+#endif
+
+// 64-byte block classifier selected by _selectScanner (CPUID, or TOK_SIMD)
+// NULL: byte-at-a-time scalar scanning
+static unsigned long long (*_classify)(const char *) = NULL;
+static const char *_scannerName = NULL;
+
+// internal function
+// picks the widest scanner the CPU supports; called from tok_Open
+static void _selectScanner(void)
+{
+	if (_scannerName)
+		return;
+
+	const char *force = getenv("TOK_SIMD");
+	_classify = NULL;
+	_scannerName = "scalar";
+	if (force && strcmp(force, "scalar") == 0)
+		return;
+
+#ifdef TOK_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2") && !(force && strcmp(force, "sse2") == 0))
+	{
+		_classify = _classify_avx2;
+		_scannerName = "avx2";
+	}
+	else if (__builtin_cpu_supports("sse2"))
+	{
+		_classify = _classify_sse2;
+		_scannerName = "sse2";
+	}
+#endif
+}
+
+// internal functions
+// block scanners: the space mask of the current 64-byte block is kept in
+// tok->mask, so one classification serves every word that starts or ends
+// inside the block; the last (< 64) bytes of the input are scanned per byte
+
+// returns the first non-space byte at or after p (or tok->end)
+static const char *_skipSpace(TOKENIZER *tok, const char *p)
+{
+	while (1)
+	{
+		if (!tok->blk || p >= tok->blk + 64)
+		{
+			if (tok->end - p < 64)
+				return _skipSpace_scalar(p, tok->end);
+			tok->blk = p;
+			tok->mask = _classify(p);
+		}
+		unsigned long long bits = ~tok->mask >> (p - tok->blk);
+		if (bits)
+			return p + __builtin_ctzll(bits);
+		p = tok->blk + 64;
+	}
+}
+
+// returns the first space byte at or after p (or tok->end)
+static const char *_findSpace(TOKENIZER *tok, const char *p)
+{
+	while (1)
+	{
+		if (!tok->blk || p >= tok->blk + 64)
+		{
+			if (tok->end - p < 64)
+				return _findSpace_scalar(p, tok->end);
+			tok->blk = p;
+			tok->mask = _classify(p);
+		}
+		unsigned long long bits = tok->mask >> (p - tok->blk);
+		if (bits)
+			return p + __builtin_ctzll(bits);
+		p = tok->blk + 64;
+	}
+}
+
+// internal function
+// reads a non-mappable stream (pipe, empty file, ...) into memory
+// return	1 if successful
+//			0 if read error or memory overflow
+static int _readAll(TOKENIZER *tok, int fd)
+{
+	size_t capacity = 65536;
+	char *data = (char *)malloc(capacity);
+	if (!data)
+		return 0;
+
+	tok->size = 0;
+	while (1)
+	{
+		if (tok->size == capacity)
+		{
+			char *newData = (char *)realloc(data, capacity * 2);
+			if (!newData)
+			{
+				free(data);
+				return 0;
+			}
+			data = newData;
+			capacity *= 2;
+		}
+		ssize_t n = read(fd, data + tok->size, capacity - tok->size);
+		if (n < 0)
+		{
+			free(data);
+			return 0;
+		}
+		if (n == 0)
+			break;
+		tok->size += n;
+	}
+	tok->base = data;
+	tok->mapped = 0;
+	return 1;
+}
+
+TOKENIZER *tok_Open(const char *filename)
+{
+	struct stat st;
+	int fd = open(filename, O_RDONLY);
+	if (fd < 0)
+		return NULL;
+
+	TOKENIZER *tok = (TOKENIZER *)malloc(sizeof(TOKENIZER));
+	if (!tok)
+	{
+		close(fd);
+		return NULL;
+	}
+	tok->base = NULL;
+	tok->size = 0;
+	tok->mapped = 0;
+	tok->buf = NULL;
+	tok->bufsize = 0;
+	tok->blk = NULL;
+	tok->mask = 0;
+	_selectScanner();
+
+	if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+	{
+		void *p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (p != MAP_FAILED)
+		{
+			madvise(p, st.st_size, MADV_SEQUENTIAL);
+			tok->base = (char *)p;
+			tok->size = st.st_size;
+			tok->mapped = 1;
+		}
+	}
+	if (!tok->mapped && !_readAll(tok, fd))
+	{
+		close(fd);
+		free(tok);
+		return NULL;
+	}
+	close(fd);
+
+	tok->cur = tok->base;
+	tok->end = tok->base + tok->size;
+	return tok;
+}
+
+const char *tok_Scanner(void)
+{
+	_selectScanner();
+	return _scannerName;
+}
+
+void tok_Close(TOKENIZER *tok)
+{
+	if (!tok)
+		return;
+	if (tok->mapped)
+		munmap(tok->base, tok->size);
+	else
+		free(tok->base);
+	free(tok->buf);
+	free(tok);
+}
+
+int tok_Next(TOKENIZER *tok, const char **word, size_t *len)
+{
+	const char *end = tok->end;
+	const char *start, *p;
+
+	if (_classify)
+		start = _skipSpace(tok, tok->cur);
+	else
+		start = _skipSpace_scalar(tok->cur, end);
+
+	if (start == end)
+	{
+		tok->cur = end;
+		return 0;
+	}
+
+	if (_classify)
+		p = _findSpace(tok, start);
+	else
+		p = _findSpace_scalar(start, end);
+
+	*word = start;
+	*len = p - start;
+	tok->cur = p;
+	return 1;
+}
+
+char *tok_NextWord(TOKENIZER *tok)
+{
+	const char *word;
+	size_t len;
+
+	if (!tok_Next(tok, &word, &len))
+		return NULL;
+
+	if (len + 1 > tok->bufsize)
+	{
+		size_t size = tok->bufsize ? tok->bufsize : 128;
+		while (size < len + 1)
+			size *= 2;
+		char *buf = (char *)realloc(tok->buf, size);
+		if (!buf)
+			return NULL;
+		tok->buf = buf;
+		tok->bufsize = size;
+	}
+	memcpy(tok->buf, word, len);
+	tok->buf[len] = '\0';
+	return tok->buf;
+}
+
+TOKENIZER *tok_Split(TOKENIZER *tok, int n)
+{
+	TOKENIZER *parts = (TOKENIZER *)malloc(n * sizeof(TOKENIZER));
+	if (!parts)
+		return NULL;
+
+	const char *start = tok->cur;
+	size_t total = tok->end - tok->cur;
+	for (int i = 0; i < n; i++)
+	{
+		const char *end = tok->cur + total * (i + 1) / n;
+		if (i == n - 1)
+			end = tok->end;
+		if (end < start)
+			end = start;
+		// 단어 중간에서 잘리지 않도록 다음 공백까지 이동
+		while (end < tok->end && !IS_SPACE(*end))
+			end++;
+
+		// 범위는 매핑을 소유하지 않음 (base == NULL)
+		parts[i].base = NULL;
+		parts[i].size = end - start;
+		parts[i].mapped = 0;
+		parts[i].cur = start;
+		parts[i].end = end;
+		parts[i].buf = NULL;
+		parts[i].bufsize = 0;
+		parts[i].blk = NULL;
+		parts[i].mask = 0;
+		start = end;
+	}
+	return parts;
+}
+
+void tok_FreeSplit(TOKENIZER *parts, int n)
+{
+	if (!parts)
+		return;
+	for (int i = 0; i < n; i++)
+		free(parts[i].buf);
+	free(parts);
+}
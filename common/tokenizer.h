@@ -0,0 +1,71 @@
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include <stddef.h> // size_t
+
+////////////////////////////////////////////////////////////////////////////////
+// TOKENIZER type definition
+// 입력 파일 전체를 메모리에 매핑하고, 공백 문자(' ', '\t', '\n', '\v', '\f', '\r')로
+// 구분된 단어를 차례로 돌려준다 (fscanf "%s"와 같은 규칙)
+typedef struct
+{
+	char	*base;		// mmap된 (또는 읽어들인) 입력의 시작 (tok_Split의 범위는 NULL)
+	size_t	size;		// 입력의 크기 (bytes)
+	int		mapped;		// 1: base가 mmap 영역, 0: malloc 영역
+	const char	*cur;	// 다음에 읽을 위치
+	const char	*end;	// 입력의 끝
+	char	*buf;		// tok_NextWord가 돌려주는 NUL-terminated 사본
+	size_t	bufsize;
+	const char	*blk;	// 공백 판별을 마친 64-byte 블록의 시작 (SIMD 경로)
+	unsigned long long	mask;	// blk의 공백 비트마스크 (bit i: blk[i]가 공백)
+} TOKENIZER;
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototype declarations
+
+/* Maps the file into memory and returns a tokenizer positioned at its start
+	regular files are mmapped; pipes and other streams are read into memory
+	return	tokenizer pointer
+			NULL if the file cannot be opened or memory overflow
+*/
+TOKENIZER *tok_Open( const char *filename);
+
+/* Releases the mapping and the tokenizer
+*/
+void tok_Close( TOKENIZER *tok);
+
+/* Finds the next word without copying it
+	*word points into the mapped input and is NOT NUL-terminated
+	return	1 if a word was found
+			0 at end of input
+*/
+int tok_Next( TOKENIZER *tok, const char **word, size_t *len);
+
+/* Finds the next word and copies it into a buffer owned by the tokenizer
+	for callers that need a C string; no length limit
+	the buffer is overwritten by the next call
+	return	NUL-terminated word
+			NULL at end of input or memory overflow
+*/
+char *tok_NextWord( TOKENIZER *tok);
+
+/* Returns the name of the whitespace scanner selected at run time
+	("avx2", "sse2" or "scalar"); the TOK_SIMD environment variable
+	can force one of them (for benchmarking)
+*/
+const char *tok_Scanner( void);
+
+/* Splits the unread part of the input into n ranges cut at whitespace, so no
+	word is split between two ranges; each range is returned as a tokenizer
+	that shares the mapping of tok (e.g. one per thread)
+	the ranges must be released with tok_FreeSplit before tok_Close(tok)
+	return	array of n tokenizers
+			NULL if overflow
+*/
+TOKENIZER *tok_Split( TOKENIZER *tok, int n);
+
+/* Releases the ranges returned by tok_Split
+*/
+void tok_FreeSplit( TOKENIZER *parts, int n);
+
+#endif